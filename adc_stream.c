@@ -0,0 +1,78 @@
+#include "adc_stream.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+#define ADC_MAX_CHANNELS 5
+
+// Amostras intercaladas na ordem crescente dos canais habilitados: a amostra i
+// pertence ao canal de posição i % num_channels. O bloco sempre recomeça no
+// início do buffer, então essa correspondência não se perde.
+static uint16_t ring[ADC_MAX_CHANNELS * ADC_STREAM_SAMPLES_PER_CHANNEL];
+static uint16_t *ring_start = ring; // Lido pelo canal de controle da DMA
+static uint8_t slot_of_channel[ADC_MAX_CHANNELS];
+static uint num_channels;
+
+void adc_stream_init(uint32_t channel_mask) {
+    adc_init();
+    int first = -1;
+    num_channels = 0;
+    for (uint ch = 0; ch < ADC_MAX_CHANNELS; ch++) {
+        if (!(channel_mask & (1u << ch)))
+            continue;
+        if (first < 0)
+            first = ch;
+        slot_of_channel[ch] = num_channels++;
+        if (ch == ADC_CHANNEL_TEMPERATURE)
+            adc_set_temp_sensor_enabled(true);
+        else
+            adc_gpio_init(26 + ch);
+    }
+    if (num_channels == 0)
+        return;
+
+    adc_select_input(first);
+    adc_set_round_robin(channel_mask);
+    adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ a cada amostra, 12 bits
+    // Clock do ADC de 48 MHz: período de (1 + div) ciclos por conversão
+    adc_set_clkdiv(48000000.0f / (ADC_STREAM_RATE_HZ * num_channels) - 1.0f);
+
+    uint data_ch = dma_claim_unused_channel(true);
+    uint ctrl_ch = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(data_ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    channel_config_set_chain_to(&c, ctrl_ch);
+    dma_channel_configure(data_ch, &c, ring, &adc_hw->fifo,
+                          num_channels * ADC_STREAM_SAMPLES_PER_CHANNEL, false);
+
+    // Ao fim de cada bloco, o canal de controle reescreve o endereço de destino
+    // (registrador com gatilho), reiniciando o canal de dados no começo do anel
+    dma_channel_config k = dma_channel_get_default_config(ctrl_ch);
+    channel_config_set_transfer_data_size(&k, DMA_SIZE_32);
+    channel_config_set_read_increment(&k, false);
+    channel_config_set_write_increment(&k, false);
+    dma_channel_configure(ctrl_ch, &k, &dma_hw->ch[data_ch].al2_write_addr_trig, &ring_start, 1, false);
+
+    dma_channel_start(data_ch);
+    adc_run(true);
+}
+
+// Média da janela mais recente de um canal
+uint16_t adc_stream_average(uint channel) {
+    uint32_t count, stride;
+    const uint16_t *samples = adc_stream_samples(channel, &count, &stride);
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++)
+        sum += samples[i * stride];
+    return (uint16_t)(sum / count);
+}
+
+// Acesso direto às amostras de um canal no anel (espaçadas de *stride)
+const uint16_t *adc_stream_samples(uint channel, uint32_t *count, uint32_t *stride) {
+    *count = ADC_STREAM_SAMPLES_PER_CHANNEL;
+    *stride = num_channels;
+    return &ring[slot_of_channel[channel]];
+}
@@ -0,0 +1,21 @@
+#ifndef ADC_STREAM_H
+#define ADC_STREAM_H
+
+// Aquisição contínua do ADC: modo round-robin entre os canais habilitados, com a
+// DMA gravando num anel que se reinicia sozinho (canal de controle encadeado).
+// A CPU não participa da conversão; os consumidores leem médias do anel.
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+#define ADC_STREAM_SAMPLES_PER_CHANNEL 16   // Janela de cada canal no anel
+#define ADC_STREAM_RATE_HZ 1000             // Amostras por segundo de cada canal
+
+#define ADC_CHANNEL_JOYSTICK_Y 0
+#define ADC_CHANNEL_JOYSTICK_X 1
+#define ADC_CHANNEL_TEMPERATURE 4           // Sensor interno do RP2040
+
+void adc_stream_init(uint32_t channel_mask);
+uint16_t adc_stream_average(uint channel);
+const uint16_t *adc_stream_samples(uint channel, uint32_t *count, uint32_t *stride);
+
+#endif // ADC_STREAM_H
@@ -0,0 +1,365 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "bench.h"
+#include "bench_ref.h"
+#include "ssd1306.h"
+#include "led_matrix.h"
+#include "output.h"
+#include "input.h"
+#include "list_view.h"
+#include "menu_tables.h"
+
+typedef struct {
+    const char *name;
+    const char *group;
+    uint32_t iterations;
+    int arg;
+    void (*setup)(int arg);   // Uma vez, antes das iterações (não medido)
+    void (*before)(int arg);  // Antes de cada iteração (não medido)
+    void (*run)(int arg);     // A iteração medida
+    void (*after)(int arg);   // Depois de cada iteração (não medido)
+    void (*expected)(int arg); // Desenha o quadro esperado com bench_ref.h (NULL: sem verificação)
+    bool check_panel;         // Confere também o painel contra o back buffer
+} bench_case_t;
+
+// ---------------------------------------------------------------------------
+// Primitivas
+
+static void run_fill_clear(int arg) { (void)arg; ssd1306_fill(&ssd, false); }
+static void run_fill_set(int arg) { (void)arg; ssd1306_fill(&ssd, true); }
+static void run_rect_outline(int arg) { (void)arg; ssd1306_rect(&ssd, 3, 5, 100, 50, true, false); }
+static void run_rect_filled(int arg) { (void)arg; ssd1306_rect(&ssd, 3, 5, 100, 50, true, true); }
+static void run_fill_rect_invert(int arg) { (void)arg; ssd1306_fill_rect(&ssd, 13, 7, 90, 37, SSD1306_INVERT); }
+static void run_draw_rect_invert(int arg) { (void)arg; ssd1306_draw_rect(&ssd, 13, 7, 90, 37, SSD1306_INVERT); }
+static void run_line_diagonal(int arg) { (void)arg; ssd1306_line(&ssd, 0, 0, 127, 63, true); }
+static void run_line_shallow(int arg) { (void)arg; ssd1306_line(&ssd, 0, 10, 127, 40, true); }
+static void run_line_steep(int arg) { (void)arg; ssd1306_line(&ssd, 100, 63, 80, 0, true); }
+static void run_hline(int arg) { (void)arg; ssd1306_hline(&ssd, 3, 120, 33, true); }
+static void run_vline(int arg) { (void)arg; ssd1306_vline(&ssd, 64, 2, 60, true); }
+static void run_string_aligned(int arg) { (void)arg; ssd1306_draw_string(&ssd, "Info Ambiental", 5, 8); }
+static void run_string_unaligned(int arg) { (void)arg; ssd1306_draw_string(&ssd, "Config Sistema", 5, 20); }
+static void run_string_latin1(int arg) { (void)arg; ssd1306_draw_string(&ssd, "Posição Informações", 0, 36); }
+
+static void run_string_screen(int arg) {
+    (void)arg;
+    ssd1306_draw_string(&ssd, "The quick brown fox jumps over the lazy dog. "
+                              "0123456789 !\"#$%&'()*+,-./:;<=>?@[]^_{|}~ "
+                              "Acentuação: àáâãçéêíóôõú ÀÁÂÃÇÉÊÍÓÔÕÚ", 0, 0);
+}
+
+// Todos os pixels, um a um (referência do custo por pixel)
+static void run_pixel_sweep(int arg) {
+    (void)arg;
+    for (int y = 0; y < HEIGHT; y++)
+        for (int x = 0; x < WIDTH; x++)
+            ssd1306_pixel(&ssd, x, y, ((x ^ y) & 1) != 0);
+}
+
+// Quadros esperados das primitivas, sobre a tela apagada
+static void expect_fill_clear(int arg) { (void)arg; }
+static void expect_fill_set(int arg) { (void)arg; ref_fill(true); }
+static void expect_rect_outline(int arg) { (void)arg; ref_rect(3, 5, 100, 50, true, false); }
+static void expect_rect_filled(int arg) { (void)arg; ref_rect(3, 5, 100, 50, true, true); }
+static void expect_fill_rect_invert(int arg) { (void)arg; ref_fill_rect(13, 7, 90, 37, SSD1306_INVERT); }
+static void expect_draw_rect_invert(int arg) { (void)arg; ref_draw_rect(13, 7, 90, 37, SSD1306_INVERT); }
+static void expect_line_diagonal(int arg) { (void)arg; ref_line(0, 0, 127, 63, true); }
+static void expect_line_shallow(int arg) { (void)arg; ref_line(0, 10, 127, 40, true); }
+static void expect_line_steep(int arg) { (void)arg; ref_line(100, 63, 80, 0, true); }
+static void expect_hline(int arg) { (void)arg; ref_hline(3, 120, 33, true); }
+static void expect_vline(int arg) { (void)arg; ref_vline(64, 2, 60, true); }
+static void expect_string_aligned(int arg) { (void)arg; ref_draw_string("Info Ambiental", 5, 8); }
+static void expect_string_unaligned(int arg) { (void)arg; ref_draw_string("Config Sistema", 5, 20); }
+static void expect_string_latin1(int arg) { (void)arg; ref_draw_string("Posição Informações", 0, 36); }
+
+static void expect_string_screen(int arg) {
+    (void)arg;
+    ref_draw_string("The quick brown fox jumps over the lazy dog. "
+                    "0123456789 !\"#$%&'()*+,-./:;<=>?@[]^_{|}~ "
+                    "Acentuação: àáâãçéêíóôõú ÀÁÂÃÇÉÊÍÓÔÕÚ", 0, 0);
+}
+
+static void expect_pixel_sweep(int arg) {
+    (void)arg;
+    for (int y = 0; y < HEIGHT; y++)
+        for (int x = 0; x < WIDTH; x++)
+            ref_pixel(x, y, ((x ^ y) & 1) != 0);
+}
+
+// ---------------------------------------------------------------------------
+// Envio: mede a codificação (swap + flush_start); a espera do barramento fica fora
+
+static void setup_flush_scene(int arg) {
+    (void)arg;
+    ssd1306_fill(&ssd, false);
+    ssd1306_draw_string(&ssd, "Info Ambiental", 5, 4);
+    ssd1306_draw_string(&ssd, "GeoLocalizacao", 5, 20);
+    ssd1306_rect(&ssd, 16, 0, WIDTH, 16, true, false);
+    ssd1306_send_data(&ssd);
+}
+
+static void before_flush_full(int arg) { (void)arg; ssd1306_invalidate(&ssd); }
+static void before_flush_cursor(int arg) { (void)arg; ssd1306_draw_rect(&ssd, 16, 0, WIDTH, 16, SSD1306_INVERT); }
+
+static void run_flush(int arg) {
+    (void)arg;
+    ssd1306_swap(&ssd);
+    ssd1306_flush_start(&ssd);
+}
+
+static void after_flush(int arg) { (void)arg; ssd1306_flush_wait(&ssd); }
+
+static void expect_flush_scene(int arg) {
+    (void)arg;
+    ref_draw_string("Info Ambiental", 5, 4);
+    ref_draw_string("GeoLocalizacao", 5, 20);
+    ref_rect(16, 0, WIDTH, 16, true, false);
+}
+
+// O contorno desenhado em SSD1306_INVERT sobre o contorno da cena o apaga
+static void expect_flush_cursor(int arg) {
+    (void)arg;
+    ref_draw_string("Info Ambiental", 5, 4);
+    ref_draw_string("GeoLocalizacao", 5, 20);
+}
+
+// ---------------------------------------------------------------------------
+// Matriz de LEDs
+
+static void setup_leds(int arg) {
+    (void)arg;
+    for (uint i = 0; i < LED_COUNT; i++)
+        led_matrix_set_pixel(i, (uint8_t)(i * 10), (uint8_t)(255 - i * 10), (uint8_t)(i & 1 ? 64 : 0));
+}
+
+static void run_led_write(int arg) { (void)arg; led_matrix_write(); }
+
+// Estimativa de corrente de um quadro: arg = 0 usa as cores de setup_leds (dentro
+// do limite); senão, palavras com todos os canais em arg sem passar pela tabela
+// de brilho (com 255, acima do limite: o quadro é atenuado)
+static led_word_t led_words[LED_COUNT];
+
+static void before_led_power(int arg) {
+    if (arg == 0) {
+        led_matrix_copy(led_words);
+        return;
+    }
+    for (uint i = 0; i < LED_COUNT; i++)
+        led_words[i] = (led_word_t)arg * 0x01010100u;
+}
+
+static void run_led_power(int arg) { (void)arg; led_matrix_power_limit(led_words, LED_COUNT); }
+
+// ---------------------------------------------------------------------------
+// Entrada: um tick do debounce (linha do teclado e, a cada 4 ticks, os botões)
+
+static void run_input_scan(int arg) { (void)arg; input_scan_step(); }
+
+// ---------------------------------------------------------------------------
+// Telas completas do menu (mostrar_menu, incluindo a publicação do quadro)
+
+static void setup_main_menu(int arg) {
+    (void)arg;
+    voltar_menu_principal();
+}
+
+static void setup_submenu(int arg) {
+    voltar_menu_principal();
+    opcao_atual = arg;
+    opcao_selecionada();
+}
+
+static void run_full_redraw(int arg) {
+    (void)arg;
+    invalidar_menu();
+    mostrar_menu();
+}
+
+static void run_cursor_move(int arg) {
+    (void)arg;
+    opcao_atual = (opcao_atual + 1) % num_opcoes;
+    mostrar_menu();
+}
+
+// Lista de um submenu sem rolagem (item i nas linhas i * LIST_VIEW_ROW_HEIGHT),
+// com o contorno da seleção e as setas dos itens fora da seleção
+static void expect_menu(uint16_t menu, int selected) {
+    int count = menu_itens[menu].num_filhos;
+    for (int i = 0; i < count && i < LIST_VIEW_ROWS; i++) {
+        int y = i * LIST_VIEW_ROW_HEIGHT;
+        ref_draw_string(menu_itens[menu_itens[menu].primeiro_filho + i].titulo, 5, y + 4);
+        if (i == selected)
+            ref_rect(y, 0, WIDTH, LIST_VIEW_ROW_HEIGHT, true, false);
+    }
+    if (count > 1 && selected > 0)
+        ref_draw_string("^", 60, 0);
+    if (count > 1 && selected < count - 1)
+        ref_draw_string("v", 60, HEIGHT - 8);
+}
+
+static void expect_main_menu(int arg) { (void)arg; expect_menu(MENU_RAIZ, 0); }
+static void expect_submenu(int arg) { expect_menu(menu_itens[MENU_RAIZ].primeiro_filho + arg, 0); }
+static void expect_cursor_move(int arg) { (void)arg; expect_menu(MENU_RAIZ, 1); }
+
+// ---------------------------------------------------------------------------
+
+static const bench_case_t single_core_cases[] = {
+    {"fill_clear", "primitive", 1000, 0, NULL, NULL, run_fill_clear, NULL, expect_fill_clear, false},
+    {"fill_set", "primitive", 1000, 0, NULL, NULL, run_fill_set, NULL, expect_fill_set, false},
+    {"rect_outline", "primitive", 1000, 0, NULL, NULL, run_rect_outline, NULL, expect_rect_outline, false},
+    {"rect_filled", "primitive", 1000, 0, NULL, NULL, run_rect_filled, NULL, expect_rect_filled, false},
+    {"fill_rect_invert", "primitive", 1000, 0, NULL, NULL, run_fill_rect_invert, NULL, expect_fill_rect_invert, false},
+    {"draw_rect_invert", "primitive", 1000, 0, NULL, NULL, run_draw_rect_invert, NULL, expect_draw_rect_invert, false},
+    {"line_diagonal", "primitive", 1000, 0, NULL, NULL, run_line_diagonal, NULL, expect_line_diagonal, false},
+    {"line_shallow", "primitive", 1000, 0, NULL, NULL, run_line_shallow, NULL, expect_line_shallow, false},
+    {"line_steep", "primitive", 1000, 0, NULL, NULL, run_line_steep, NULL, expect_line_steep, false},
+    {"hline", "primitive", 1000, 0, NULL, NULL, run_hline, NULL, expect_hline, false},
+    {"vline", "primitive", 1000, 0, NULL, NULL, run_vline, NULL, expect_vline, false},
+    {"string_aligned", "primitive", 1000, 0, NULL, NULL, run_string_aligned, NULL, expect_string_aligned, false},
+    {"string_unaligned", "primitive", 1000, 0, NULL, NULL, run_string_unaligned, NULL, expect_string_unaligned, false},
+    {"string_latin1", "primitive", 1000, 0, NULL, NULL, run_string_latin1, NULL, expect_string_latin1, false},
+    {"string_screen", "primitive", 200, 0, NULL, NULL, run_string_screen, NULL, expect_string_screen, false},
+    {"pixel_sweep", "primitive", 20, 0, NULL, NULL, run_pixel_sweep, NULL, expect_pixel_sweep, false},
+    {"flush_full", "flush", 50, 0, setup_flush_scene, before_flush_full, run_flush, after_flush, expect_flush_scene, true},
+    {"flush_cursor", "flush", 50, 0, setup_flush_scene, before_flush_cursor, run_flush, after_flush, expect_flush_cursor, true},
+    {"flush_idle", "flush", 1000, 0, setup_flush_scene, NULL, run_flush, after_flush, expect_flush_scene, true},
+    {"led_matrix_write", "led", 100, 0, setup_leds, NULL, run_led_write, NULL, NULL, false},
+    {"led_power_estimate", "led", 1000, 0, setup_leds, before_led_power, run_led_power, NULL, NULL, false},
+    {"led_power_limit", "led", 1000, 255, NULL, before_led_power, run_led_power, NULL, NULL, false},
+    {"input_scan", "input", 1000, 0, NULL, NULL, run_input_scan, NULL, NULL, false},
+};
+
+// Depois de output_init: o envio ao OLED passa ao núcleo 1
+static const bench_case_t dual_core_cases[] = {
+    {"scene_main_menu", "scene", 200, 0, setup_main_menu, NULL, run_full_redraw, NULL, expect_main_menu, false},
+    {"scene_submenu_info", "scene", 200, 0, setup_submenu, NULL, run_full_redraw, NULL, expect_submenu, false},
+    {"scene_submenu_geo", "scene", 200, 1, setup_submenu, NULL, run_full_redraw, NULL, expect_submenu, false},
+    {"scene_submenu_alerts", "scene", 200, 2, setup_submenu, NULL, run_full_redraw, NULL, expect_submenu, false},
+    {"scene_submenu_config", "scene", 200, 3, setup_submenu, NULL, run_full_redraw, NULL, expect_submenu, false},
+    {"scene_cursor_move", "scene", 200, 0, setup_main_menu, NULL, run_cursor_move, NULL, expect_cursor_move, false},
+};
+
+static void run_hooks(const bench_case_t *c, bool setup) {
+    if (setup && c->setup)
+        c->setup(c->arg);
+    if (c->before)
+        c->before(c->arg);
+    c->run(c->arg);
+    if (c->after)
+        c->after(c->arg);
+}
+
+static void run_case(const bench_case_t *c, bench_result_t *r, uint32_t scale, bench_golden_fn_t golden) {
+    memset(r, 0, sizeof(*r));
+    r->name = c->name;
+    r->group = c->group;
+    r->iterations = c->iterations * scale;
+    r->min_ns = UINT64_MAX;
+    r->min_cycles = UINT32_MAX;
+    r->golden = -1;
+
+    bench_quiet(true);
+    if (c->expected) {
+        static uint8_t expected[WIDTH * HEIGHT / 8];
+        ssd1306_fill(&ssd, false);
+        run_hooks(c, true);
+        ref_fill(false);
+        c->expected(c->arg);
+        ref_pages(expected);
+        if (golden)
+            r->golden = golden(c->name, &ssd.ram_buffer[1], expected, c->check_panel);
+        else
+            r->golden = memcmp(&ssd.ram_buffer[1], expected, sizeof(expected)) == 0;
+    }
+
+    ssd1306_fill(&ssd, false);
+    if (c->setup)
+        c->setup(c->arg);
+    for (uint32_t i = 0; i < r->iterations; i++) {
+        if (c->before)
+            c->before(c->arg);
+        uint64_t t0 = bench_now_ns();
+        uint32_t c0 = bench_cycles();
+        c->run(c->arg);
+        uint32_t c1 = bench_cycles();
+        uint64_t t1 = bench_now_ns();
+        if (c->after)
+            c->after(c->arg);
+
+        uint64_t ns = t1 - t0;
+        uint32_t cycles = bench_cycles_elapsed(c0, c1);
+        r->total_ns += ns;
+        r->total_cycles += cycles;
+        if (ns < r->min_ns) r->min_ns = ns;
+        if (ns > r->max_ns) r->max_ns = ns;
+        if (cycles < r->min_cycles) r->min_cycles = cycles;
+        if (cycles > r->max_cycles) r->max_cycles = cycles;
+    }
+    if (strcmp(c->group, "flush") == 0)
+        r->bytes = (uint32_t)ssd.bytes_sent;
+    bench_quiet(false);
+}
+
+uint32_t bench_run_all(bench_result_t *results, uint32_t max_results, uint32_t iteration_scale,
+                       bench_golden_fn_t golden) {
+    uint32_t n = 0;
+    if (iteration_scale == 0)
+        iteration_scale = 1;
+
+    bench_quiet(true);
+    iniciar_oled();
+    led_matrix_init();
+    bench_quiet(false);
+
+    for (uint32_t i = 0; i < count_of(single_core_cases) && n < max_results; i++)
+        run_case(&single_core_cases[i], &results[n++], iteration_scale, golden);
+
+    output_init(&ssd);
+    for (uint32_t i = 0; i < count_of(dual_core_cases) && n < max_results; i++)
+        run_case(&dual_core_cases[i], &results[n++], iteration_scale, golden);
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Saída
+
+static const char *golden_label(int golden) {
+    return golden < 0 ? "-" : golden ? "ok" : "FAIL";
+}
+
+void bench_write_csv(FILE *out, const bench_result_t *results, uint32_t count) {
+    bool cycles = bench_cycles_available();
+    fprintf(out, "platform,group,case,iterations,mean_ns,min_ns,max_ns,mean_cycles,min_cycles,max_cycles,bytes,golden\n");
+    for (uint32_t i = 0; i < count; i++) {
+        const bench_result_t *r = &results[i];
+        uint32_t n = r->iterations ? r->iterations : 1;
+        fprintf(out, "%s,%s,%s,%lu,%llu,%llu,%llu,", bench_platform_name(), r->group, r->name,
+                (unsigned long)r->iterations, (unsigned long long)(r->total_ns / n),
+                (unsigned long long)r->min_ns, (unsigned long long)r->max_ns);
+        if (cycles)
+            fprintf(out, "%llu,%lu,%lu,", (unsigned long long)(r->total_cycles / n),
+                    (unsigned long)r->min_cycles, (unsigned long)r->max_cycles);
+        else
+            fputs(",,,", out);
+        fprintf(out, "%lu,%s\n", (unsigned long)r->bytes, golden_label(r->golden));
+    }
+}
+
+void bench_write_json(FILE *out, const bench_result_t *results, uint32_t count) {
+    bool cycles = bench_cycles_available();
+    fprintf(out, "{\n  \"platform\": \"%s\",\n  \"cases\": [\n", bench_platform_name());
+    for (uint32_t i = 0; i < count; i++) {
+        const bench_result_t *r = &results[i];
+        uint32_t n = r->iterations ? r->iterations : 1;
+        fprintf(out, "    {\"group\": \"%s\", \"case\": \"%s\", \"iterations\": %lu, "
+                     "\"mean_ns\": %llu, \"min_ns\": %llu, \"max_ns\": %llu",
+                r->group, r->name, (unsigned long)r->iterations, (unsigned long long)(r->total_ns / n),
+                (unsigned long long)r->min_ns, (unsigned long long)r->max_ns);
+        if (cycles)
+            fprintf(out, ", \"mean_cycles\": %llu, \"min_cycles\": %lu, \"max_cycles\": %lu",
+                    (unsigned long long)(r->total_cycles / n), (unsigned long)r->min_cycles,
+                    (unsigned long)r->max_cycles);
+        fprintf(out, ", \"bytes\": %lu, \"golden\": \"%s\"}%s\n", (unsigned long)r->bytes,
+                golden_label(r->golden), i + 1 < count ? "," : "");
+    }
+    fputs("  ]\n}\n", out);
+}
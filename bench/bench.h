@@ -0,0 +1,48 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Benchmarks das primitivas do ssd1306, do caminho de envio, da matriz de LEDs
+// e das telas do menu. bench.c é comum; a medição de tempo e a saída ficam em
+// bench_host.c (relógio de alta resolução, verificação contra quadros de
+// referência) e bench_pico.c (time_us_64 e contador SysTick do RP2040).
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define BENCH_MAX_CASES 40
+
+typedef struct {
+    const char *name;
+    const char *group;        // "primitive", "flush", "led" ou "scene"
+    uint32_t iterations;
+    uint64_t total_ns;        // Soma das iterações medidas
+    uint64_t min_ns, max_ns;
+    uint64_t total_cycles;    // Ciclos de CPU (0 se a plataforma não tem contador)
+    uint32_t min_cycles, max_cycles;
+    uint32_t bytes;           // Bytes I2C do último envio (casos de flush)
+    int golden;               // 1 = confere, 0 = diverge, -1 = sem verificação
+} bench_result_t;
+
+// Plataforma
+const char *bench_platform_name(void);
+uint64_t bench_now_ns(void);
+bool bench_cycles_available(void);
+uint32_t bench_cycles(void);              // Contador crescente (diferença módulo 2^24 no RP2040)
+uint32_t bench_cycles_elapsed(uint32_t start, uint32_t end);
+void bench_quiet(bool quiet);             // Silencia o printf do firmware durante as medições
+
+// Verificação do back buffer (páginas da GDDRAM) de um caso: expected é o quadro
+// desenhado pelo renderizador de referência (bench_ref.h); com check_panel, confere
+// também que o painel recebeu o mesmo conteúdo. Retorna 1 se confere, 0 se diverge.
+// Sem essa função (NULL), o back buffer é comparado só com expected.
+typedef int (*bench_golden_fn_t)(const char *name, const uint8_t *pages, const uint8_t *expected,
+                                 bool check_panel);
+
+// Executa todos os casos; iteration_scale multiplica as iterações padrão (0 = 1)
+uint32_t bench_run_all(bench_result_t *results, uint32_t max_results, uint32_t iteration_scale,
+                       bench_golden_fn_t golden);
+
+void bench_write_csv(FILE *out, const bench_result_t *results, uint32_t count);
+void bench_write_json(FILE *out, const bench_result_t *results, uint32_t count);
+
+#endif // BENCH_H
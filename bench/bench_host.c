@@ -0,0 +1,210 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench.h"
+#include "sim.h"
+#include "ssd1306.h"
+
+// Benchmarks no host: o firmware roda sobre a simulação (relógio virtual), mas o
+// tempo medido é o do processador do host. Cada caso com verificação compara o
+// back buffer com o renderizador de referência (bench_ref.c) e com
+// bench/golden/<caso>.pbm; um arquivo ausente é uma falha. Com -u os arquivos são
+// regravados a partir do renderizador de referência.
+//
+// Uso: BitDogLab-Menu-bench [-c saida.csv] [-j saida.json] [-g dir] [-n escala] [-u]
+// Sem -c/-j, o CSV vai para a saída padrão.
+
+#ifndef BENCH_GOLDEN_DIR
+#define BENCH_GOLDEN_DIR "bench/golden"
+#endif
+
+#define PAGE_BYTES (WIDTH * HEIGHT / 8)
+#define PBM_ROW_BYTES (WIDTH / 8)
+
+static const char *golden_dir = BENCH_GOLDEN_DIR;
+static bool update_golden;
+static uint32_t golden_failures;
+
+const char *bench_platform_name(void) {
+    return "host";
+}
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+bool bench_cycles_available(void) {
+    return false;
+}
+
+uint32_t bench_cycles(void) {
+    return 0;
+}
+
+uint32_t bench_cycles_elapsed(uint32_t start, uint32_t end) {
+    return end - start;
+}
+
+void bench_quiet(bool quiet) {
+    static int saved_fd = -1;
+    fflush(stdout);
+    if (quiet && saved_fd < 0) {
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd < 0)
+            return;
+        saved_fd = dup(STDOUT_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    } else if (!quiet && saved_fd >= 0) {
+        dup2(saved_fd, STDOUT_FILENO);
+        close(saved_fd);
+        saved_fd = -1;
+    }
+}
+
+// Páginas da GDDRAM (bit 0 na linha de cima) <-> PBM P4 (1 = preto, pixel aceso = branco)
+static void pages_to_pbm(const uint8_t *pages, uint8_t *pbm) {
+    memset(pbm, 0xFF, PAGE_BYTES);
+    for (uint y = 0; y < HEIGHT; y++)
+        for (uint x = 0; x < WIDTH; x++)
+            if ((pages[(y / 8) * WIDTH + x] >> (y % 8)) & 1u)
+                pbm[y * PBM_ROW_BYTES + x / 8] &= (uint8_t)~(0x80u >> (x % 8));
+}
+
+static bool write_pbm(const char *path, const uint8_t *pages) {
+    uint8_t pbm[PAGE_BYTES];
+    pages_to_pbm(pages, pbm);
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+    fprintf(f, "P4\n%d %d\n", WIDTH, HEIGHT);
+    fwrite(pbm, 1, sizeof(pbm), f);
+    return fclose(f) == 0;
+}
+
+static bool read_pbm(const char *path, uint8_t *pbm) {
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    int w = 0, h = 0;
+    bool ok = fscanf(f, "P4 %d %d", &w, &h) == 2 && w == WIDTH && h == HEIGHT && fgetc(f) != EOF &&
+              fread(pbm, 1, PAGE_BYTES, f) == PAGE_BYTES;
+    fclose(f);
+    return ok;
+}
+
+// Grava o quadro do driver ao lado da referência para inspeção
+static void write_actual(const char *name, const uint8_t *pages) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.actual.pbm", golden_dir, name);
+    write_pbm(path, pages);
+    fprintf(stderr, "%s: gravado %s\n", name, path);
+}
+
+static int check_golden(const char *name, const uint8_t *pages, const uint8_t *expected, bool check_panel) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.pbm", golden_dir, name);
+
+    if (check_panel && memcmp(sim_oled_ram(), pages, PAGE_BYTES) != 0) {
+        fprintf(stderr, "%s: o painel não recebeu o back buffer\n", name);
+        golden_failures++;
+        return 0;
+    }
+
+    if (memcmp(pages, expected, PAGE_BYTES) != 0) {
+        fprintf(stderr, "%s: quadro difere do renderizador de referência\n", name);
+        write_actual(name, pages);
+        golden_failures++;
+        return 0;
+    }
+
+    // Os arquivos de referência vêm do renderizador de referência, nunca do driver
+    if (update_golden) {
+        if (!write_pbm(path, expected)) {
+            fprintf(stderr, "falha ao gravar %s\n", path);
+            golden_failures++;
+            return 0;
+        }
+        return 1;
+    }
+
+    uint8_t golden[PAGE_BYTES], actual[PAGE_BYTES];
+    if (!read_pbm(path, golden)) {
+        fprintf(stderr, "%s: sem quadro de referência %s (gere com -u)\n", name, path);
+        golden_failures++;
+        return 0;
+    }
+    pages_to_pbm(pages, actual);
+    if (memcmp(golden, actual, PAGE_BYTES) == 0)
+        return 1;
+
+    fprintf(stderr, "%s: quadro difere de %s\n", name, path);
+    write_actual(name, pages);
+    golden_failures++;
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "uso: %s [-c saida.csv] [-j saida.json] [-g dir] [-n escala] [-u]\n", prog);
+    exit(2);
+}
+
+static FILE *open_output(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    return f;
+}
+
+int main(int argc, char **argv) {
+    const char *csv_path = NULL, *json_path = NULL;
+    uint32_t scale = 1;
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        if (!strcmp(opt, "-u")) {
+            update_golden = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+            usage(argv[0]);
+        const char *val = argv[++i];
+        if (!strcmp(opt, "-c"))
+            csv_path = val;
+        else if (!strcmp(opt, "-j"))
+            json_path = val;
+        else if (!strcmp(opt, "-g"))
+            golden_dir = val;
+        else if (!strcmp(opt, "-n"))
+            scale = (uint32_t)strtoul(val, NULL, 10);
+        else
+            usage(argv[0]);
+    }
+
+    static bench_result_t results[BENCH_MAX_CASES];
+    sim_init();
+    uint32_t count = bench_run_all(results, BENCH_MAX_CASES, scale, check_golden);
+
+    if (csv_path) {
+        FILE *f = open_output(csv_path);
+        bench_write_csv(f, results, count);
+        fclose(f);
+    }
+    if (json_path) {
+        FILE *f = open_output(json_path);
+        bench_write_json(f, results, count);
+        fclose(f);
+    }
+    if (!csv_path && !json_path)
+        bench_write_csv(stdout, results, count);
+
+    if (golden_failures)
+        fprintf(stderr, "%lu caso(s) divergem do quadro de referência\n", (unsigned long)golden_failures);
+    fflush(stdout);
+    sim_exit(golden_failures ? 1 : 0);
+}
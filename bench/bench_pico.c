@@ -0,0 +1,62 @@
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/structs/systick.h"
+#include "bench.h"
+
+// Benchmarks no RP2040: tempo por time_us_64 e ciclos pelo SysTick (24 bits, no
+// clock do processador). O printf do firmware é desligado durante as medições e
+// os resultados saem pela USB no fim, entre marcadores, para captura no host:
+//   ---8<--- bench.csv / ---8<--- bench.json / ---8<--- fim
+
+#define BENCH_USB_WAIT_MS 5000  // Espera pelo terminal antes de começar
+#define SYSTICK_MASK 0xFFFFFFu
+
+const char *bench_platform_name(void) {
+    return "rp2040";
+}
+
+uint64_t bench_now_ns(void) {
+    return time_us_64() * 1000u;
+}
+
+bool bench_cycles_available(void) {
+    return true;
+}
+
+// O SysTick conta para baixo; devolve o complemento para que o valor cresça
+uint32_t bench_cycles(void) {
+    return SYSTICK_MASK - (systick_hw->cvr & SYSTICK_MASK);
+}
+
+uint32_t bench_cycles_elapsed(uint32_t start, uint32_t end) {
+    return (end - start) & SYSTICK_MASK;
+}
+
+void bench_quiet(bool quiet) {
+    stdio_flush();
+    stdio_set_driver_enabled(&stdio_usb, !quiet);
+}
+
+int main() {
+    static bench_result_t results[BENCH_MAX_CASES];
+
+    stdio_init_all();
+    for (uint i = 0; i < BENCH_USB_WAIT_MS / 10 && !stdio_usb_connected(); i++)
+        sleep_ms(10);
+
+    // SysTick livre: recarga máxima, clock do processador, sem interrupção
+    systick_hw->rvr = SYSTICK_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+
+    uint32_t count = bench_run_all(results, BENCH_MAX_CASES, 1, NULL);
+
+    printf("---8<--- bench.csv\n");
+    bench_write_csv(stdout, results, count);
+    printf("---8<--- bench.json\n");
+    bench_write_json(stdout, results, count);
+    printf("---8<--- fim\n");
+
+    while (true)
+        sleep_ms(1000);
+}
@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bench_ref.h"
+#include "font_atlas.h"
+
+static bool frame[HEIGHT][WIDTH];
+
+static void apply(int x, int y, ssd1306_mode_t mode) {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+        return;
+    frame[y][x] = mode == SSD1306_INVERT ? !frame[y][x] : mode == SSD1306_SET;
+}
+
+void ref_pixel(int x, int y, bool value) {
+    apply(x, y, value ? SSD1306_SET : SSD1306_CLEAR);
+}
+
+void ref_fill(bool value) {
+    for (int y = 0; y < HEIGHT; y++)
+        for (int x = 0; x < WIDTH; x++)
+            frame[y][x] = value;
+}
+
+void ref_fill_rect(int top, int left, int width, int height, ssd1306_mode_t mode) {
+    for (int y = top; y < top + height; y++)
+        for (int x = left; x < left + width; x++)
+            apply(x, y, mode);
+}
+
+// Cada pixel do contorno uma vez (os cantos não se repetem com SSD1306_INVERT)
+void ref_draw_rect(int top, int left, int width, int height, ssd1306_mode_t mode) {
+    for (int y = top; y < top + height; y++)
+        for (int x = left; x < left + width; x++)
+            if (y == top || y == top + height - 1 || x == left || x == left + width - 1)
+                apply(x, y, mode);
+}
+
+void ref_rect(int top, int left, int width, int height, bool value, bool fill) {
+    ssd1306_mode_t mode = value ? SSD1306_SET : SSD1306_CLEAR;
+    if (fill)
+        ref_fill_rect(top, left, width, height, mode);
+    else
+        ref_draw_rect(top, left, width, height, mode);
+}
+
+void ref_line(int x0, int y0, int x1, int y1, bool value) {
+    int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int err = dx - dy;
+    while (true) {
+        ref_pixel(x0, y0, value);
+        if (x0 == x1 && y0 == y1)
+            break;
+        int e2 = err * 2;
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void ref_hline(int x0, int x1, int y, bool value) {
+    for (int x = x0 < x1 ? x0 : x1; x <= (x0 < x1 ? x1 : x0); x++)
+        ref_pixel(x, y, value);
+}
+
+void ref_vline(int x, int y0, int y1, bool value) {
+    for (int y = y0 < y1 ? y0 : y1; y <= (y0 < y1 ? y1 : y0); y++)
+        ref_pixel(x, y, value);
+}
+
+// O glifo substitui o fundo da sua célula 8x8; quebra de linha como no driver
+void ref_draw_string(const char *str, int x, int y) {
+    while (*str) {
+        const uint8_t *glyph = font_atlas[font_atlas_index(ssd1306_utf8_next(&str))];
+        for (int c = 0; c < FONT_ATLAS_GLYPH_WIDTH; c++)
+            for (int r = 0; r < 8; r++)
+                ref_pixel(x + c, y + r, (glyph[c] >> r) & 1u);
+        x += FONT_ATLAS_GLYPH_WIDTH;
+        if (x + FONT_ATLAS_GLYPH_WIDTH > WIDTH) {
+            x = 0;
+            y += 8;
+        }
+        if (y + 8 > HEIGHT)
+            break;
+    }
+}
+
+void ref_pages(uint8_t *pages) {
+    memset(pages, 0, WIDTH * HEIGHT / 8);
+    for (int y = 0; y < HEIGHT; y++)
+        for (int x = 0; x < WIDTH; x++)
+            if (frame[y][x])
+                pages[(y / 8) * WIDTH + x] |= (uint8_t)(1u << (y % 8));
+}
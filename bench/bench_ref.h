@@ -0,0 +1,25 @@
+#ifndef BENCH_REF_H
+#define BENCH_REF_H
+
+// Renderizador de referência dos benchmarks: as mesmas primitivas do ssd1306,
+// escritas pixel a pixel num quadro de bools, sem máscaras, páginas nem regiões
+// alteradas. O quadro esperado de cada caso é desenhado aqui e comparado com o
+// back buffer do driver.
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+void ref_pixel(int x, int y, bool value);
+void ref_fill(bool value);
+void ref_rect(int top, int left, int width, int height, bool value, bool fill);
+void ref_fill_rect(int top, int left, int width, int height, ssd1306_mode_t mode);
+void ref_draw_rect(int top, int left, int width, int height, ssd1306_mode_t mode);
+void ref_line(int x0, int y0, int x1, int y1, bool value);
+void ref_hline(int x0, int x1, int y, bool value);
+void ref_vline(int x, int y0, int y1, bool value);
+void ref_draw_string(const char *str, int x, int y);
+
+// Quadro de referência no formato da GDDRAM (WIDTH * HEIGHT / 8 bytes, bit 0 na linha de cima)
+void ref_pages(uint8_t *pages);
+
+#endif // BENCH_REF_H
@@ -0,0 +1,44 @@
+#include "debounce.h"
+
+void debounce_init(debounce_t *d) {
+    *d = (debounce_t){0};
+}
+
+void debounce_set_long_press(debounce_t *d, uint input, uint32_t long_us) {
+    if (input >= DEBOUNCE_INPUTS)
+        return;
+    d->long_us[input] = long_us;
+    if (long_us)
+        d->long_mask |= 1u << input;
+    else
+        d->long_mask &= ~(1u << input);
+}
+
+void debounce_update(debounce_t *d, uint32_t sample, uint32_t active, uint32_t now_us, debounce_edges_t *edges) {
+    // Conta as amostras diferentes do estado aceito; a quarta estoura o contador
+    // (volta a 00) e inverte o estado. Uma amostra igual zera o contador.
+    uint32_t delta = (sample ^ d->state) & active;
+    uint32_t cnt1 = (d->cnt1 ^ d->cnt0) & delta;
+    uint32_t cnt0 = ~d->cnt0 & delta;
+    d->cnt1 = (d->cnt1 & ~active) | cnt1;
+    d->cnt0 = (d->cnt0 & ~active) | cnt0;
+    uint32_t toggle = delta & ~(cnt0 | cnt1);
+    d->state ^= toggle;
+
+    edges->pressed = toggle & d->state;
+    edges->released = toggle & ~d->state;
+    edges->long_pressed = 0;
+
+    // Pressionamento longo: os laços só percorrem as bordas e as entradas
+    // mantidas que ainda esperam o prazo, normalmente nenhuma
+    for (uint32_t p = edges->pressed & d->long_mask; p; p &= p - 1)
+        d->since_us[__builtin_ctz(p)] = now_us;
+    edges->short_released = edges->released & d->long_mask & ~d->long_sent;
+    d->long_sent &= d->state;
+    for (uint32_t w = d->state & d->long_mask & ~d->long_sent; w; w &= w - 1) {
+        uint i = (uint)__builtin_ctz(w);
+        if (now_us - d->since_us[i] >= d->long_us[i])
+            edges->long_pressed |= 1u << i;
+    }
+    d->long_sent |= edges->long_pressed;
+}
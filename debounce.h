@@ -0,0 +1,46 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+// Debounce de até 32 entradas em paralelo com contadores verticais: o bit i de
+// cnt0 e cnt1 forma o contador de 2 bits da entrada i, e cada amostra atualiza
+// todos os contadores com meia dúzia de operações lógicas, independente do
+// número de entradas. Uma entrada muda de estado depois de
+// DEBOUNCE_SAMPLES amostras seguidas diferentes do estado aceito; qualquer
+// amostra igual zera o seu contador.
+//
+// As entradas fora de active numa chamada não são amostradas (contador e
+// estado ficam como estavam), o que permite amostrar grupos em ticks
+// diferentes, como as linhas de um teclado matricial.
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+#define DEBOUNCE_INPUTS 32
+#define DEBOUNCE_SAMPLES 4     // Fixo pelos contadores de 2 bits
+
+typedef struct {
+    uint32_t cnt0, cnt1;       // Contadores verticais
+    uint32_t state;            // Estado aceito (1 = ativo)
+    uint32_t long_mask;        // Entradas com pressionamento longo configurado
+    uint32_t long_sent;        // ... já sinalizado neste pressionamento
+    uint32_t long_us[DEBOUNCE_INPUTS];
+    uint32_t since_us[DEBOUNCE_INPUTS]; // Instante em que a entrada ficou ativa
+} debounce_t;
+
+// Bordas aceitas numa amostra
+typedef struct {
+    uint32_t pressed;
+    uint32_t released;
+    uint32_t long_pressed;     // Ativas há long_us (uma vez por pressionamento)
+    uint32_t short_released;   // Soltas antes de long_us (só entradas com long_us)
+} debounce_edges_t;
+
+void debounce_init(debounce_t *d);
+void debounce_set_long_press(debounce_t *d, uint input, uint32_t long_us); // 0 desliga
+void debounce_update(debounce_t *d, uint32_t sample, uint32_t active, uint32_t now_us, debounce_edges_t *edges);
+
+static inline bool debounce_active(const debounce_t *d, uint input) {
+    return (d->state >> input) & 1u;
+}
+
+#endif // DEBOUNCE_H
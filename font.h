@@ -1,5 +1,6 @@
 
 // Fontes para A-Z e 0-9. Os caracteres tem 8x8 pixels
+// Fonte de dados do tools/gen_font_atlas.py, que gera o font_atlas.h (ASCII + Latin-1)
 
 
 static uint8_t font[] = {
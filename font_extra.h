@@ -0,0 +1,92 @@
+// Glifos complementares ao font.h: pontuação ASCII, símbolos Latin-1 e marcas
+// diacríticas. Mesmo formato do font.h (8 colunas por caractere, bit 0 = linha de cima).
+// Não é incluído pelo firmware: tools/gen_font_atlas.py lê este arquivo e o font.h,
+// compõe as letras acentuadas (base + marca) e gera o font_atlas.h usado pelo ssd1306.c.
+// O comentário de cada linha identifica o caractere.
+
+static const uint8_t font_extra[] = {
+
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // espaço
+    0x00, 0x00, 0x5f, 0x00, 0x00, 0x00, 0x00, 0x00, // !
+    0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, // "
+    0x14, 0x7f, 0x14, 0x7f, 0x14, 0x00, 0x00, 0x00, // #
+    0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00, 0x00, 0x00, // $
+    0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x00, 0x00, // %
+    0x36, 0x49, 0x55, 0x22, 0x50, 0x00, 0x00, 0x00, // &
+    0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, // '
+    0x00, 0x1c, 0x22, 0x41, 0x00, 0x00, 0x00, 0x00, // (
+    0x00, 0x41, 0x22, 0x1c, 0x00, 0x00, 0x00, 0x00, // )
+    0x14, 0x08, 0x3e, 0x08, 0x14, 0x00, 0x00, 0x00, // *
+    0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00, 0x00, // +
+    0x00, 0x80, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, // ,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, // -
+    0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, // .
+    0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, // /
+    0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, // :
+    0x00, 0x80, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, // ;
+    0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00, 0x00, // <
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x00, 0x00, // =
+    0x41, 0x22, 0x14, 0x08, 0x00, 0x00, 0x00, 0x00, // >
+    0x02, 0x01, 0x51, 0x09, 0x06, 0x00, 0x00, 0x00, // ?
+    0x3e, 0x41, 0x5d, 0x55, 0x5e, 0x00, 0x00, 0x00, // @
+    0x00, 0x7f, 0x41, 0x41, 0x00, 0x00, 0x00, 0x00, // [
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x00, 0x00, // barra invertida
+    0x00, 0x41, 0x41, 0x7f, 0x00, 0x00, 0x00, 0x00, // ]
+    0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00, // ^
+    0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x00, // _
+    0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, // `
+    0x00, 0x08, 0x36, 0x41, 0x00, 0x00, 0x00, 0x00, // {
+    0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, // |
+    0x00, 0x41, 0x36, 0x08, 0x00, 0x00, 0x00, 0x00, // }
+    0x08, 0x04, 0x08, 0x10, 0x08, 0x04, 0x00, 0x00, // ~
+    0x00, 0x00, 0x7d, 0x00, 0x00, 0x00, 0x00, 0x00, // ¡
+    0x18, 0x24, 0x7e, 0x24, 0x24, 0x00, 0x00, 0x00, // ¢
+    0x48, 0x3e, 0x49, 0x41, 0x42, 0x60, 0x00, 0x00, // £
+    0x22, 0x1c, 0x14, 0x1c, 0x22, 0x00, 0x00, 0x00, // ¤
+    0x29, 0x2a, 0x7c, 0x2a, 0x29, 0x00, 0x00, 0x00, // ¥
+    0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x00, 0x00, // ¦
+    0x4a, 0x55, 0x55, 0x29, 0x00, 0x00, 0x00, 0x00, // §
+    0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, // ¨
+    0x3e, 0x41, 0x5d, 0x55, 0x41, 0x3e, 0x00, 0x00, // ©
+    0x48, 0x55, 0x55, 0x5e, 0x00, 0x00, 0x00, 0x00, // ª
+    0x08, 0x14, 0x22, 0x08, 0x14, 0x22, 0x00, 0x00, // «
+    0x04, 0x04, 0x04, 0x04, 0x1c, 0x00, 0x00, 0x00, // ¬
+    0x00, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, // soft hyphen
+    0x3e, 0x41, 0x7d, 0x55, 0x69, 0x3e, 0x00, 0x00, // ®
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, // ¯
+    0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00, 0x00, // °
+    0x44, 0x44, 0x5f, 0x44, 0x44, 0x00, 0x00, 0x00, // ±
+    0x00, 0x19, 0x15, 0x12, 0x00, 0x00, 0x00, 0x00, // ²
+    0x11, 0x15, 0x15, 0x0a, 0x00, 0x00, 0x00, 0x00, // ³
+    0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, // ´
+    0xfc, 0x20, 0x40, 0x40, 0x3c, 0x40, 0x00, 0x00, // µ
+    0x06, 0x0f, 0x7f, 0x01, 0x7f, 0x00, 0x00, 0x00, // ¶
+    0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, // ·
+    0x00, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, // ¸
+    0x12, 0x1f, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, // ¹
+    0x26, 0x29, 0x29, 0x26, 0x00, 0x00, 0x00, 0x00, // º
+    0x22, 0x14, 0x08, 0x22, 0x14, 0x08, 0x00, 0x00, // »
+    0x27, 0x10, 0x28, 0x34, 0x7a, 0x21, 0x00, 0x00, // ¼
+    0x27, 0x10, 0x08, 0x04, 0x6a, 0x59, 0x40, 0x00, // ½
+    0x25, 0x1f, 0x28, 0x34, 0x7a, 0x21, 0x00, 0x00, // ¾
+    0x30, 0x48, 0x45, 0x40, 0x20, 0x00, 0x00, 0x00, // ¿
+    0x7e, 0x09, 0x09, 0x7f, 0x49, 0x49, 0x41, 0x00, // Æ
+    0x49, 0x7f, 0x49, 0x41, 0x3e, 0x00, 0x00, 0x00, // Ð
+    0x22, 0x14, 0x08, 0x14, 0x22, 0x00, 0x00, 0x00, // ×
+    0x5e, 0x31, 0x29, 0x25, 0x23, 0x1e, 0x00, 0x00, // Ø
+    0x7f, 0x12, 0x12, 0x12, 0x0c, 0x00, 0x00, 0x00, // Þ
+    0x7e, 0x01, 0x49, 0x36, 0x00, 0x00, 0x00, 0x00, // ß
+    0x20, 0x54, 0x54, 0x38, 0x54, 0x54, 0x48, 0x00, // æ
+    0x20, 0x55, 0x52, 0x55, 0x38, 0x00, 0x00, 0x00, // ð
+    0x08, 0x08, 0x2a, 0x08, 0x08, 0x00, 0x00, 0x00, // ÷
+    0x78, 0x24, 0x54, 0x4c, 0x78, 0x04, 0x00, 0x00, // ø
+    0xfe, 0x28, 0x24, 0x24, 0x18, 0x00, 0x00, 0x00, // þ
+    0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // marca grave
+    0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // marca aguda
+    0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, // marca circunflexa
+    0x02, 0x01, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, // marca til
+    0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, // marca trema
+    0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // marca anel
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00  // marca cedilha
+
+    };
@@ -0,0 +1,239 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "sim.h"
+#include "input.h"
+#include "led_matrix.h"
+#include "keypad.h"
+
+// Executável do host: roda o firmware (main de BitDogLab-Menu.c, renomeado para
+// bitdoglab_main pelo CMake) sobre a simulação, guiado por um roteiro de entradas.
+//
+// Uso: BitDogLab-Menu-host [-s roteiro] [-e "cmd; cmd"] [-t ms] [-o oled.pbm]
+//                          [-l leds.ppm] [-a]
+//
+// Comandos do roteiro (um por linha ou separados por ';', '#' inicia comentário):
+//   wait MS            avança o roteiro MS milissegundos
+//   press PINO         nível baixo no pino (botões têm pull-up)
+//   release PINO       solta o pino
+//   tap PINO [MS]      press e, MS depois (padrão 100), release
+//   keydown TECLA | keyup TECLA | key TECLA [MS]
+//                      teclado matricial (TECLA de KEYPAD_LAYOUT; '#' é escrito hash)
+//   adc CANAL VALOR    leitura de 12 bits de um canal do ADC
+//   joy up|down|left|right|center
+//   usb TEXTO          caracteres recebidos pela serial USB (ex.: "usb t" imprime o trace)
+//   oled ARQ.pbm | leds ARQ.ppm | ascii
+//   end                encerra a simulação
+// PINO aceita número ou A, B, PB.
+
+#define HOST_BOTAO_B 6
+#define HOST_TAP_MS 100
+#define HOST_TAIL_MS 500        // Tempo simulado após o fim do roteiro
+#define HOST_LED_SCALE 16
+#define HOST_MAX_COMMANDS 256
+
+int bitdoglab_main(void);
+
+typedef struct {
+    char op[8];
+    char arg[64];
+    long value;
+} command_t;
+
+static command_t script[HOST_MAX_COMMANDS];
+static uint script_len;
+static uint script_pc;
+static long run_ms = -1;
+static const char *oled_path;
+static const char *leds_path;
+static bool ascii_at_exit;
+
+static int parse_pin(const char *s) {
+    if (!strcasecmp(s, "A"))
+        return BOTAO_A;
+    if (!strcasecmp(s, "B"))
+        return HOST_BOTAO_B;
+    if (!strcasecmp(s, "PB"))
+        return JOYSTICK_PB;
+    char *end;
+    long pin = strtol(s, &end, 10);
+    return (*s && !*end && pin >= 0 && pin < NUM_BANK0_GPIOS) ? (int)pin : -1;
+}
+
+static int parse_key(const char *s) {
+    static const char layout[] = KEYPAD_LAYOUT;
+    if (!strcasecmp(s, "hash"))
+        s = "#";
+    const char *at = s[0] && !s[1] ? strchr(layout, toupper((unsigned char)s[0])) : NULL;
+    return at ? (int)(at - layout) : -1;
+}
+
+static void set_key(uint index, bool closed) {
+    static const uint rows[KEYPAD_ROWS] = KEYPAD_ROW_PINS;
+    static const uint cols[KEYPAD_COLS] = KEYPAD_COL_PINS;
+    sim_gpio_switch(rows[index / KEYPAD_COLS], cols[index % KEYPAD_COLS], closed);
+}
+
+static void parse_script(char *text) {
+    for (char *line = strtok(text, ";\n"); line; line = strtok(NULL, ";\n")) {
+        char *comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+        command_t c = {0};
+        char arg2[32] = "";
+        int n = sscanf(line, "%7s %63s %31s", c.op, c.arg, arg2);
+        if (n <= 0)
+            continue;
+        c.value = n >= 3 ? strtol(arg2, NULL, 10) : -1;
+        if (script_len == HOST_MAX_COMMANDS) {
+            fprintf(stderr, "roteiro: mais de %d comandos\n", HOST_MAX_COMMANDS);
+            exit(2);
+        }
+        script[script_len++] = c;
+    }
+}
+
+static void release_pin(void *arg) {
+    sim_gpio_release_input((uint)(uintptr_t)arg);
+}
+
+static void release_key(void *arg) {
+    set_key((uint)(uintptr_t)arg, false);
+}
+
+static void finish(void *arg) {
+    (void)arg;
+    sim_exit(0);
+}
+
+static void dump(void) {
+    if (oled_path && !sim_dump_oled_pbm(oled_path))
+        fprintf(stderr, "falha ao gravar %s\n", oled_path);
+    if (leds_path && !sim_dump_leds_ppm(leds_path, COLS, ROWS, HOST_LED_SCALE))
+        fprintf(stderr, "falha ao gravar %s\n", leds_path);
+    if (ascii_at_exit) {
+        sim_dump_oled_ascii(stdout);
+        sim_dump_leds_ascii(stdout, COLS, ROWS);
+    }
+}
+
+static void on_exit_dump(int status) {
+    (void)status;
+    fflush(stdout);
+    dump();
+}
+
+// Executa os comandos do roteiro até o próximo wait
+static void script_step(void *arg) {
+    (void)arg;
+    while (script_pc < script_len) {
+        command_t *c = &script[script_pc++];
+        int pin = parse_pin(c->arg);
+        int key = parse_key(c->arg);
+        if (!strcmp(c->op, "wait")) {
+            sim_schedule(sim_now_us() + (uint64_t)atol(c->arg) * 1000, script_step, NULL);
+            return;
+        } else if (!strcmp(c->op, "press") && pin >= 0) {
+            sim_gpio_set_input(pin, false);
+        } else if (!strcmp(c->op, "release") && pin >= 0) {
+            sim_gpio_release_input(pin);
+        } else if (!strcmp(c->op, "tap") && pin >= 0) {
+            sim_gpio_set_input(pin, false);
+            long hold = c->value > 0 ? c->value : HOST_TAP_MS;
+            sim_schedule(sim_now_us() + (uint64_t)hold * 1000, release_pin, (void *)(uintptr_t)pin);
+        } else if (!strcmp(c->op, "keydown") && key >= 0) {
+            set_key(key, true);
+        } else if (!strcmp(c->op, "keyup") && key >= 0) {
+            set_key(key, false);
+        } else if (!strcmp(c->op, "key") && key >= 0) {
+            set_key(key, true);
+            long hold = c->value > 0 ? c->value : HOST_TAP_MS;
+            sim_schedule(sim_now_us() + (uint64_t)hold * 1000, release_key, (void *)(uintptr_t)key);
+        } else if (!strcmp(c->op, "adc")) {
+            sim_adc_set((uint)atoi(c->arg), (uint16_t)c->value);
+        } else if (!strcmp(c->op, "joy")) {
+            // Eixo Y no canal 0 (alto = cima), eixo X no canal 1
+            uint16_t y = 2048, x = 2048;
+            if (!strcmp(c->arg, "up")) y = 4095;
+            else if (!strcmp(c->arg, "down")) y = 0;
+            else if (!strcmp(c->arg, "right")) x = 4095;
+            else if (!strcmp(c->arg, "left")) x = 0;
+            sim_adc_set(0, y);
+            sim_adc_set(1, x);
+        } else if (!strcmp(c->op, "usb")) {
+            sim_usb_input(c->arg);
+        } else if (!strcmp(c->op, "oled")) {
+            if (!sim_dump_oled_pbm(c->arg))
+                fprintf(stderr, "falha ao gravar %s\n", c->arg);
+        } else if (!strcmp(c->op, "leds")) {
+            if (!sim_dump_leds_ppm(c->arg, COLS, ROWS, HOST_LED_SCALE))
+                fprintf(stderr, "falha ao gravar %s\n", c->arg);
+        } else if (!strcmp(c->op, "ascii")) {
+            fflush(stdout);
+            sim_dump_oled_ascii(stdout);
+        } else if (!strcmp(c->op, "end")) {
+            sim_exit(0);
+        } else {
+            fprintf(stderr, "roteiro: comando invalido '%s %s'\n", c->op, c->arg);
+            sim_exit(2);
+        }
+    }
+    if (run_ms < 0)
+        sim_schedule(sim_now_us() + HOST_TAIL_MS * 1000, finish, NULL);
+}
+
+static char *read_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    char *text = malloc(size + 1);
+    size_t got = fread(text, 1, size, f);
+    text[got] = '\0';
+    fclose(f);
+    return text;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "uso: %s [-s roteiro] [-e \"cmd; cmd\"] [-t ms] [-o oled.pbm] [-l leds.ppm] [-a]\n", prog);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        if (!strcmp(opt, "-a")) {
+            ascii_at_exit = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+            usage(argv[0]);
+        const char *val = argv[++i];
+        if (!strcmp(opt, "-s"))
+            parse_script(read_file(val));
+        else if (!strcmp(opt, "-e"))
+            parse_script(strdup(val));
+        else if (!strcmp(opt, "-t"))
+            run_ms = atol(val);
+        else if (!strcmp(opt, "-o"))
+            oled_path = val;
+        else if (!strcmp(opt, "-l"))
+            leds_path = val;
+        else
+            usage(argv[0]);
+    }
+
+    sim_init();
+    sim_set_exit_handler(on_exit_dump);
+    sim_schedule(0, script_step, NULL);
+    if (run_ms >= 0)
+        sim_schedule((uint64_t)run_ms * 1000, finish, NULL);
+
+    bitdoglab_main();
+    sim_exit(0);
+}
@@ -0,0 +1,31 @@
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+// ADC simulado: cada canal devolve o valor definido com sim_adc_set. Em modo
+// contínuo, as conversões acontecem no ritmo do divisor de clock e alimentam
+// o FIFO/DREQ consumido pela DMA simulada.
+#include "pico/types.h"
+
+typedef struct {
+    io_rw_32 cs;
+    io_ro_32 result;
+    io_rw_32 fcs;
+    io_ro_32 fifo;
+    io_rw_32 div;
+} adc_hw_t;
+
+extern adc_hw_t *const adc_hw;
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+uint16_t adc_read(void);
+void adc_set_round_robin(uint input_mask);
+void adc_set_temp_sensor_enabled(bool enable);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain(void);
+
+#endif // HOST_HARDWARE_ADC_H
@@ -0,0 +1,18 @@
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+
+#include "pico/types.h"
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_ref = 4,
+    clk_sys = 5,
+    clk_peri = 6,
+    clk_usb = 7,
+    clk_adc = 8,
+    clk_rtc = 9,
+};
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#endif // HOST_HARDWARE_CLOCKS_H
@@ -0,0 +1,71 @@
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+// DMA simulada: canais com DREQ do ADC avançam a cada conversão, canais com DREQ
+// de TX de uma PIO sempre que o FIFO dela tem espaço e canais sem DREQ
+// transferem tudo ao serem disparados. Os registradores de endereço têm a largura
+// de um ponteiro do host, então um canal de controle pode reescrever o endereço
+// de outro canal (al2_write_addr_trig etc.) como no RP2040.
+#include "pico/types.h"
+
+#define NUM_DMA_CHANNELS 12
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2,
+};
+
+#define DREQ_PIO0_TX0 0
+#define DREQ_PIO1_TX0 8
+#define DREQ_ADC 36
+#define DREQ_FORCE 0x3f
+
+typedef struct {
+    volatile uintptr_t read_addr;
+    volatile uintptr_t write_addr;
+    volatile uintptr_t transfer_count;
+    volatile uintptr_t ctrl_trig;
+    volatile uintptr_t al1_ctrl;
+    volatile uintptr_t al1_read_addr;
+    volatile uintptr_t al1_write_addr;
+    volatile uintptr_t al1_transfer_count_trig;
+    volatile uintptr_t al2_ctrl;
+    volatile uintptr_t al2_transfer_count;
+    volatile uintptr_t al2_read_addr;
+    volatile uintptr_t al2_write_addr_trig;
+    volatile uintptr_t al3_ctrl;
+    volatile uintptr_t al3_write_addr;
+    volatile uintptr_t al3_transfer_count;
+    volatile uintptr_t al3_read_addr_trig;
+} dma_channel_hw_t;
+
+typedef struct {
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+extern dma_hw_t *const dma_hw;
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+
+static inline dma_channel_hw_t *dma_channel_hw_addr(uint channel) {
+    return &dma_hw->ch[channel];
+}
+
+#endif // HOST_HARDWARE_DMA_H
@@ -0,0 +1,7 @@
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+// As interrupções simuladas (GPIO e alarmes) são entregues por host/sim_time.c
+#include "pico/types.h"
+
+#endif // HOST_HARDWARE_IRQ_H
@@ -0,0 +1,117 @@
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+
+// PIO simulada instrução a instrução (host/sim_pio.c): o programa carregado
+// roda a cada ciclo do divisor de clock (parte inteira e fração de 8 bits, como
+// no RP2040), com atrasos, side-set, autopull e FIFO de TX. As bordas dos pinos
+// alimentam a fita de LEDs WS2812 virtual e podem ser gravadas (sim_pio_capture).
+// Subconjunto suportado: jmp (menos a condição pin), out, pull, set e nop.
+#include "pico/types.h"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+
+#define PIO_INSTRUCTION_COUNT 32
+
+enum pio_fifo_join {
+    PIO_FIFO_JOIN_NONE = 0,
+    PIO_FIFO_JOIN_TX = 1,
+    PIO_FIFO_JOIN_RX = 2,
+};
+
+typedef struct pio_program {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+    uint8_t pio_version;
+} pio_program_t;
+
+typedef struct {
+    uint wrap_target, wrap;
+    uint set_base, set_count;
+    uint out_base, out_count;
+    uint sideset_base;
+    uint sideset_bits;          // Inclui o bit de habilitação se opcional
+    bool sideset_optional;
+    float clkdiv;
+    bool out_shift_right, autopull;
+    uint pull_threshold;
+    uint fifo_join;
+} pio_sm_config;
+
+typedef struct pio_hw {
+    volatile uint32_t txf[4];   // Destino da DMA; só a escrita pela DMA é simulada
+    uint program_offset;
+    uint16_t instr_mem[PIO_INSTRUCTION_COUNT];
+    bool claimed[4];
+    pio_sm_config config[4];
+    bool enabled[4];
+} pio_hw_t;
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t *const host_pio0;
+extern pio_hw_t *const host_pio1;
+#define pio0 host_pio0
+#define pio1 host_pio1
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_gpio_init(PIO pio, uint pin);
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm);
+
+pio_sm_config pio_get_default_sm_config(void);
+
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return (pio == pio1 ? DREQ_PIO1_TX0 : DREQ_PIO0_TX0) + (is_tx ? 0 : 4) + sm;
+}
+
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+    c->wrap_target = wrap_target;
+    c->wrap = wrap;
+}
+
+static inline void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count) {
+    c->set_base = set_base;
+    c->set_count = set_count;
+}
+
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+    c->out_base = out_base;
+    c->out_count = out_count;
+}
+
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+    c->sideset_base = sideset_base;
+}
+
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+    (void)pindirs;
+    c->sideset_bits = bit_count;
+    c->sideset_optional = optional;
+}
+
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+    c->clkdiv = div;
+}
+
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+    c->fifo_join = join;
+}
+
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    c->out_shift_right = shift_right;
+    c->autopull = autopull;
+    c->pull_threshold = pull_threshold ? pull_threshold : 32;
+}
+
+static inline void sm_config_set_out_special(pio_sm_config *c, bool sticky, bool has_enable_pin, uint enable_pin) {
+    (void)c;
+    (void)sticky;
+    (void)has_enable_pin;
+    (void)enable_pin;
+}
+
+#endif // HOST_HARDWARE_PIO_H
@@ -0,0 +1,16 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/types.h"
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+void __wfi(void);
+void __wfe(void);
+void __sev(void);
+
+static inline void __dmb(void) {
+}
+
+#endif // HOST_HARDWARE_SYNC_H
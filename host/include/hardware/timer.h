@@ -0,0 +1,12 @@
+#ifndef HOST_HARDWARE_TIMER_H
+#define HOST_HARDWARE_TIMER_H
+
+#include "pico/types.h"
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+void busy_wait_us(uint64_t us);
+void busy_wait_us_32(uint32_t us);
+void busy_wait_ms(uint32_t ms);
+
+#endif // HOST_HARDWARE_TIMER_H
@@ -0,0 +1,9 @@
+#ifndef HOST_PICO_BOOTROM_H
+#define HOST_PICO_BOOTROM_H
+
+#include "pico/types.h"
+
+// No host, reiniciar em BOOTSEL encerra a simulação
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask);
+
+#endif // HOST_PICO_BOOTROM_H
@@ -0,0 +1,17 @@
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+// Núcleo 1 simulado como corrotina: roda sempre que o núcleo 0 espera
+#include "pico/types.h"
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_reset_core1(void);
+
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t data);
+uint32_t multicore_fifo_pop_blocking(void);
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *out);
+void multicore_fifo_drain(void);
+
+#endif // HOST_PICO_MULTICORE_H
@@ -0,0 +1,11 @@
+#ifndef HOST_PICO_STDIO_USB_H
+#define HOST_PICO_STDIO_USB_H
+
+#include <stdbool.h>
+
+// A saída padrão do host faz o papel de um terminal sempre conectado
+static inline bool stdio_usb_connected(void) {
+    return true;
+}
+
+#endif // HOST_PICO_STDIO_USB_H
@@ -0,0 +1,23 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// Subconjunto do Pico SDK usado pelo firmware, implementado por host/sim_*.c
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define PICO_ERROR_TIMEOUT (-1)
+
+#ifndef PICO_DEFAULT_LED_PIN
+#define PICO_DEFAULT_LED_PIN 25
+#endif
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+int putchar_raw(int c);
+uint get_core_num(void);
+void tight_loop_contents(void);
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,29 @@
+#ifndef HOST_PICO_SYNC_H
+#define HOST_PICO_SYNC_H
+
+// Os núcleos simulados se alternam cooperativamente, então a seção crítica só
+// precisa mascarar as interrupções do núcleo atual
+#include "pico/types.h"
+#include "hardware/sync.h"
+
+typedef struct {
+    uint32_t save;
+} critical_section_t;
+
+static inline void critical_section_init(critical_section_t *cs) {
+    cs->save = 0;
+}
+
+static inline void critical_section_enter_blocking(critical_section_t *cs) {
+    cs->save = save_and_disable_interrupts();
+}
+
+static inline void critical_section_exit(critical_section_t *cs) {
+    restore_interrupts(cs->save);
+}
+
+static inline void critical_section_deinit(critical_section_t *cs) {
+    (void)cs;
+}
+
+#endif // HOST_PICO_SYNC_H
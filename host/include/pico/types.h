@@ -0,0 +1,15 @@
+#ifndef HOST_PICO_TYPES_H
+#define HOST_PICO_TYPES_H
+
+// Tipos básicos do Pico SDK para a compilação no host (ver host/sim.h)
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t; // Microssegundos desde o boot simulado
+
+typedef volatile uint32_t io_rw_32;
+typedef volatile uint32_t io_ro_32;
+
+#endif // HOST_PICO_TYPES_H
@@ -0,0 +1,12 @@
+#ifndef HOST_TUSB_H
+#define HOST_TUSB_H
+
+#include <stdint.h>
+
+// A saída padrão do host consome tudo na hora: o FIFO de TX do CDC
+// (CFG_TUD_CDC_TX_BUFSIZE no SDK) está sempre vazio
+static inline uint32_t tud_cdc_write_available(void) {
+    return 256;
+}
+
+#endif // HOST_TUSB_H
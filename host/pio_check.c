@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "led_matrix.h"
+
+// Confere a forma de onda do ws2812b.pio contra o datasheet do WS2812B: roda o
+// programa gerado na PIO simulada (host/sim_pio.c) com o mesmo
+// ws2812b_program_init do firmware, para cada clk_sys pedido, envia um quadro
+// de teste e mede cada bit na borda do pino. Sai com código 1 se algum tempo
+// sair da tolerância ou se a fita virtual decodificar cores diferentes das
+// enviadas.
+//
+// Uso: BitDogLab-Menu-piocheck [-c clk_sys_hz]... [-w onda.vcd]
+//   -c  frequências a conferir (padrão: 125, 133, 200 e 48 MHz)
+//   -w  grava a forma de onda da primeira frequência (VCD, 1 ns)
+
+#define CHECK_WORDS LED_COUNT
+#define CHECK_MAX_EDGES (CHECK_WORDS * 24 * 2 + 16)
+#define CHECK_MAX_CLOCKS 8
+#define CHECK_MAX_REPORTS 8     // Bits divergentes listados por frequência
+
+// WS2812B (Worldsemi, datasheet v1.0): tempos nominais com tolerância de ±150 ns;
+// o período de um bit é 1,25 us ±600 ns
+typedef struct {
+    const char *name;
+    uint32_t min_ns, max_ns;
+    uint32_t seen_min, seen_max;
+} timing_t;
+
+enum { T0H, T0L, T1H, T1L, PERIOD, NUM_TIMINGS };
+
+static const timing_t datasheet[NUM_TIMINGS] = {
+    [T0H] = {"T0H", 250, 550, 0, 0},
+    [T0L] = {"T0L", 700, 1000, 0, 0},
+    [T1H] = {"T1H", 650, 950, 0, 0},
+    [T1L] = {"T1L", 300, 600, 0, 0},
+    [PERIOD] = {"bit", 650, 1850, 0, 0},
+};
+
+static sim_edge_t edges[CHECK_MAX_EDGES];
+
+static void timing_add(timing_t *t, uint64_t ns) {
+    if (t->seen_max == 0 || ns < t->seen_min)
+        t->seen_min = (uint32_t)ns;
+    if (ns > t->seen_max)
+        t->seen_max = (uint32_t)ns;
+}
+
+// Quadro com transições em todas as combinações de bits vizinhos
+static void test_words(uint32_t *words) {
+    static const uint32_t fixed[] = {0x00000000u, 0xffffff00u, 0xaaaaaa00u, 0x55555500u, 0x0f0f0f00u};
+    uint32_t state = 0x12345678u;
+    for (uint i = 0; i < CHECK_WORDS; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        words[i] = i < count_of(fixed) ? fixed[i] : state & 0xffffff00u;
+    }
+}
+
+static bool check_clock(uint32_t sys_hz, const char *vcd_path) {
+    uint32_t words[CHECK_WORDS];
+    test_words(words);
+
+    sim_set_sys_hz(sys_hz);
+    sim_init();
+    uint offset = pio_add_program(pio0, &ws2812b_program);
+    uint sm = (uint)pio_claim_unused_sm(pio0, true);
+    ws2812b_program_init(pio0, sm, offset, MATRIX_LED_PIN);
+
+    sim_pio_capture(edges, CHECK_MAX_EDGES);
+    for (uint i = 0; i < CHECK_WORDS; i++)
+        pio_sm_put_blocking(pio0, sm, words[i]);
+    sim_run_for_us(CHECK_WORDS * LED_US_PER_LED + LED_RESET_US);
+    uint count = sim_pio_captured();
+    sim_pio_capture(NULL, 0);
+    if (vcd_path && !sim_dump_vcd(vcd_path, edges, count))
+        fprintf(stderr, "falha ao gravar %s\n", vcd_path);
+
+    float div = (float)sys_hz / 8000000.0f;
+    printf("clk_sys %.3f MHz, divisor %.4f (%u + %u/256)\n", sys_hz / 1e6, div, (uint)div,
+           (uint)((div - (float)(uint)div) * 256.0f));
+
+    // Bordas alternadas subida/descida a partir da primeira subida
+    timing_t t[NUM_TIMINGS];
+    memcpy(t, datasheet, sizeof(t));
+    bool ok = true;
+    uint bits = 0, wrong = 0;
+    for (uint i = 0; i + 1 < count; i += 2) {
+        if (!edges[i].level || edges[i + 1].level) {
+            printf("  borda fora de ordem em %llu ns\n", (unsigned long long)edges[i].t_ns);
+            ok = false;
+            break;
+        }
+        uint64_t high = edges[i + 1].t_ns - edges[i].t_ns;
+        bool expected = (words[bits / 24] >> (31 - bits % 24)) & 1u;
+        bool one = high > (datasheet[T0H].max_ns + datasheet[T1H].min_ns) / 2;
+        if (one != expected && wrong++ < CHECK_MAX_REPORTS)
+            printf("  bit %u: enviado %u, pulso de %llu ns\n", bits, expected, (unsigned long long)high);
+        timing_add(&t[one ? T1H : T0H], high);
+        if (i + 2 < count) { // O último nível baixo é a pausa de trava
+            timing_add(&t[one ? T1L : T0L], edges[i + 2].t_ns - edges[i + 1].t_ns);
+            timing_add(&t[PERIOD], edges[i + 2].t_ns - edges[i].t_ns);
+        }
+        bits++;
+    }
+    if (wrong) {
+        printf("  %u bits decodificados errado\n", wrong);
+        ok = false;
+    }
+    if (bits != CHECK_WORDS * 24) {
+        printf("  %u bits na linha, esperados %u\n", bits, CHECK_WORDS * 24);
+        ok = false;
+    }
+
+    printf("  %-6s %8s %8s %8s %8s %8s\n", "tempo", "min", "max", "limite-", "limite+", "folga");
+    for (uint i = 0; i < NUM_TIMINGS; i++) {
+        if (t[i].seen_max == 0)
+            continue;
+        int32_t margin_low = (int32_t)t[i].seen_min - (int32_t)t[i].min_ns;
+        int32_t margin_high = (int32_t)t[i].max_ns - (int32_t)t[i].seen_max;
+        int32_t margin = margin_low < margin_high ? margin_low : margin_high;
+        printf("  %-6s %8u %8u %8u %8u %8ld%s\n", t[i].name, t[i].seen_min, t[i].seen_max, t[i].min_ns,
+               t[i].max_ns, (long)margin, margin < 0 ? "  FORA" : "");
+        if (margin < 0)
+            ok = false;
+    }
+
+    // Cores que a fita virtual decodificou
+    uint leds;
+    const sim_rgb_t *rgb = sim_leds(&leds);
+    wrong = 0;
+    for (uint i = 0; i < CHECK_WORDS; i++) {
+        uint32_t got = i < leds ? (uint32_t)rgb[i].g << 24 | (uint32_t)rgb[i].r << 16 | (uint32_t)rgb[i].b << 8 : 0;
+        if (got != words[i] && wrong++ < CHECK_MAX_REPORTS)
+            printf("  LED %u: enviado %08lx, fita %08lx\n", i, (unsigned long)words[i], (unsigned long)got);
+    }
+    if (wrong) {
+        printf("  %u LEDs com cor errada na fita\n", wrong);
+        ok = false;
+    }
+    printf("  %s\n", ok ? "ok" : "FALHOU");
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    uint32_t clocks[CHECK_MAX_CLOCKS];
+    uint num_clocks = 0;
+    const char *vcd_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-c") && i + 1 < argc && num_clocks < CHECK_MAX_CLOCKS) {
+            clocks[num_clocks++] = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+            vcd_path = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [-c clk_sys_hz]... [-w onda.vcd]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_clocks == 0) {
+        static const uint32_t defaults[] = {125000000, 133000000, 200000000, 48000000};
+        memcpy(clocks, defaults, sizeof(defaults));
+        num_clocks = count_of(defaults);
+    }
+
+    bool ok = true;
+    for (uint i = 0; i < num_clocks; i++)
+        ok &= check_clock(clocks[i], i == 0 ? vcd_path : NULL);
+    return ok ? 0 : 1;
+}
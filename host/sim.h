@@ -0,0 +1,64 @@
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+// Simulação do RP2040 para a compilação no host (opção BITDOGLAB_HOST_BUILD do CMake).
+// O firmware é compilado sem alterações contra os cabeçalhos de host/include;
+// estas funções controlam o ambiente simulado: relógio virtual, agenda de
+// eventos, entradas (GPIO e ADC) e a leitura/gravação do OLED e da matriz de LEDs.
+//
+// Modelo de execução: o núcleo 0 é a thread do programa e o núcleo 1 uma
+// corrotina que roda sempre que o núcleo 0 espera (WFI/WFE, sleep, FIFO cheio).
+// O tempo só avança nessas esperas e a cada leitura do relógio (1 us), então a
+// simulação é determinística: o mesmo roteiro gera sempre as mesmas saídas.
+#include <stdio.h>
+#include "pico/types.h"
+
+#define SIM_NEVER UINT64_MAX
+#define SIM_LED_MAX 64
+
+typedef struct {
+    uint8_t r, g, b;
+} sim_rgb_t;
+
+// Borda de um pino controlado pela PIO
+typedef struct {
+    uint64_t t_ns;
+    uint8_t pin;
+    bool level;
+} sim_edge_t;
+
+typedef void (*sim_event_fn_t)(void *arg);
+
+// Relógio e agenda
+void sim_init(void);
+uint64_t sim_now_us(void);                                      // Lê sem avançar o relógio
+void sim_schedule(uint64_t at_us, sim_event_fn_t fn, void *arg); // Executa fn no instante at_us
+void sim_run_for_us(uint64_t us);                               // Núcleo 0 ocioso por us (interrupções e núcleo 1 rodam)
+void sim_set_exit_handler(void (*handler)(int status));
+void sim_set_sys_hz(uint32_t hz);                               // clk_sys (padrão 125 MHz); antes de configurar a PIO
+void sim_exit(int status) __attribute__((noreturn));
+
+// Entradas
+void sim_gpio_set_input(uint gpio, bool level);  // Nível externo no pino (gera as bordas de IRQ)
+void sim_gpio_release_input(uint gpio);          // Pino volta a seguir os pull-ups/downs
+void sim_gpio_switch(uint a, uint b, bool closed); // Chave entre dois pinos (tecla do teclado matricial)
+void sim_adc_set(uint channel, uint16_t value);  // Leitura de 12 bits do canal (4 = sensor de temperatura)
+void sim_usb_input(const char *text);            // Caracteres recebidos pela serial USB (getchar_timeout_us)
+
+// Saídas
+bool sim_gpio_output(uint gpio);
+const sim_rgb_t *sim_leds(uint *count);          // Cores latched pela fita WS2812 virtual
+void sim_pio_capture(sim_edge_t *edges, uint max); // Grava as bordas dos pinos da PIO (NULL para)
+uint sim_pio_captured(void);                     // Bordas gravadas (as que não couberam se perdem)
+const uint8_t *sim_oled_ram(void);               // GDDRAM do SSD1306 virtual, página a página
+bool sim_oled_display(uint8_t *contrast);        // Painel ligado (SET_DISP) e contraste atual
+uint8_t sim_oled_start_line(void);               // Linha da GDDRAM exibida no topo
+
+// Gravação: PBM (P4) e PPM (P6) binários; ASCII com '#' para pixel aceso
+bool sim_dump_oled_pbm(const char *path);
+bool sim_dump_leds_ppm(const char *path, uint cols, uint rows, uint scale);
+void sim_dump_oled_ascii(FILE *out);
+void sim_dump_leds_ascii(FILE *out, uint cols, uint rows);
+bool sim_dump_vcd(const char *path, const sim_edge_t *edges, uint count); // Forma de onda (VCD, 1 ns)
+
+#endif // HOST_SIM_H
@@ -0,0 +1,122 @@
+#include "sim.h"
+#include "ssd1306.h"
+#include "hardware/gpio.h"
+
+// Gravação do OLED e da matriz de LEDs virtuais. O OLED é lido da GDDRAM
+// (página a página, bit 0 na linha de cima) a partir da linha inicial, como o
+// painel a exibe; pixel aceso aparece branco, como no painel.
+
+static bool oled_pixel(const uint8_t *ram, uint x, uint y) {
+    y = (y + sim_oled_start_line()) % HEIGHT;
+    return (ram[(y / 8) * WIDTH + x] >> (y % 8)) & 1u;
+}
+
+bool sim_dump_oled_pbm(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+    const uint8_t *ram = sim_oled_ram();
+    fprintf(f, "P4\n%d %d\n", WIDTH, HEIGHT);
+    for (uint y = 0; y < HEIGHT; y++) {
+        for (uint x = 0; x < WIDTH; x += 8) {
+            uint8_t byte = 0;
+            for (uint b = 0; b < 8; b++) {
+                if (!oled_pixel(ram, x + b, y)) // No PBM, 1 é preto
+                    byte |= 0x80u >> b;
+            }
+            fputc(byte, f);
+        }
+    }
+    return fclose(f) == 0;
+}
+
+void sim_dump_oled_ascii(FILE *out) {
+    const uint8_t *ram = sim_oled_ram();
+    fputc('+', out);
+    for (uint x = 0; x < WIDTH; x++)
+        fputc('-', out);
+    fputs("+\n", out);
+    for (uint y = 0; y < HEIGHT; y++) {
+        fputc('|', out);
+        for (uint x = 0; x < WIDTH; x++)
+            fputc(oled_pixel(ram, x, y) ? '#' : ' ', out);
+        fputs("|\n", out);
+    }
+    fputc('+', out);
+    for (uint x = 0; x < WIDTH; x++)
+        fputc('-', out);
+    fputs("+\n", out);
+    // O conteúdo acima é a GDDRAM, mantida com o painel desligado
+    uint8_t contrast;
+    if (!sim_oled_display(&contrast))
+        fputs("(painel desligado)\n", out);
+    else if (contrast != 0xFF)
+        fprintf(out, "(contraste 0x%02x)\n", contrast);
+}
+
+// Índice na fita do LED na linha row (0 em cima) e coluna col: serpentina a
+// partir do canto de baixo, o mesmo mapeamento de led_matrix_index
+static uint led_strip_index(uint cols, uint rows, uint row, uint col) {
+    uint r = rows - 1 - row;
+    return (r % 2 == 0) ? r * cols + (cols - 1 - col) : r * cols + col;
+}
+
+// A matriz como é vista na placa; cada LED vira um quadrado de scale x scale pixels
+bool sim_dump_leds_ppm(const char *path, uint cols, uint rows, uint scale) {
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+    uint count;
+    const sim_rgb_t *leds = sim_leds(&count);
+    if (scale == 0)
+        scale = 1;
+    fprintf(f, "P6\n%u %u\n255\n", cols * scale, rows * scale);
+    for (uint y = 0; y < rows * scale; y++) {
+        for (uint x = 0; x < cols * scale; x++) {
+            uint i = led_strip_index(cols, rows, y / scale, x / scale);
+            sim_rgb_t c = i < count ? leds[i] : (sim_rgb_t){0, 0, 0};
+            fputc(c.r, f);
+            fputc(c.g, f);
+            fputc(c.b, f);
+        }
+    }
+    return fclose(f) == 0;
+}
+
+void sim_dump_leds_ascii(FILE *out, uint cols, uint rows) {
+    uint count;
+    const sim_rgb_t *leds = sim_leds(&count);
+    for (uint r = 0; r < rows; r++) {
+        for (uint c = 0; c < cols; c++) {
+            uint i = led_strip_index(cols, rows, r, c);
+            sim_rgb_t p = i < count ? leds[i] : (sim_rgb_t){0, 0, 0};
+            fprintf(out, "%s%02x%02x%02x", c ? " " : "", p.r, p.g, p.b);
+        }
+        fputc('\n', out);
+    }
+}
+
+// Uma variável por pino que aparece nas bordas; tempo em ns desde o início
+bool sim_dump_vcd(const char *path, const sim_edge_t *edges, uint count) {
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+    bool used[NUM_BANK0_GPIOS] = {false};
+    for (uint i = 0; i < count; i++)
+        used[edges[i].pin % NUM_BANK0_GPIOS] = true;
+    fprintf(f, "$timescale 1ns $end\n$scope module pio $end\n");
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        if (used[pin])
+            fprintf(f, "$var wire 1 %c gpio%u $end\n", '!' + pin, pin);
+    }
+    fprintf(f, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        if (used[pin])
+            fprintf(f, "0%c\n", '!' + pin);
+    }
+    fprintf(f, "$end\n");
+    for (uint i = 0; i < count; i++)
+        fprintf(f, "#%llu\n%u%c\n", (unsigned long long)edges[i].t_ns, edges[i].level ? 1u : 0u,
+                '!' + edges[i].pin % NUM_BANK0_GPIOS);
+    return fclose(f) == 0;
+}
@@ -0,0 +1,17 @@
+#ifndef HOST_SIM_INTERNAL_H
+#define HOST_SIM_INTERNAL_H
+
+// Ligações entre os módulos da simulação (não usar no firmware)
+#include "sim.h"
+#include "hardware/gpio.h"
+
+void sim_periph_init(void);
+void sim_periph_advance(uint64_t from_us, uint64_t to_us); // Conversões do ADC e DMA no intervalo
+void sim_irq_gpio(uint gpio, uint32_t events);              // Enfileira uma IRQ de GPIO no núcleo 0
+void sim_irq_set_gpio_callback(gpio_irq_callback_t callback);
+bool sim_dma_dreq(uint dreq);                               // Uma transferência de um canal pacejado por dreq
+void sim_pio_init(void);
+void sim_pio_advance(uint64_t to_ns);                       // Roda as máquinas de estados até to_ns
+bool sim_pio_txf_write(uintptr_t addr, uint32_t value);     // Escrita da DMA num FIFO de TX
+
+#endif // HOST_SIM_INTERNAL_H
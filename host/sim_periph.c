@@ -0,0 +1,617 @@
+#include <string.h>
+#include "sim_internal.h"
+#include "ssd1306_hal.h"
+#include "pico/stdlib.h"
+#include "pico/bootrom.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+
+// Periféricos simulados: GPIO, I2C (só o clock; o SSD1306 é ssd1306_hal_mock.c),
+// ADC em modo contínuo, DMA e clocks. A PIO e a fita WS2812 ficam em sim_pio.c.
+
+#define SIM_SYS_HZ 125000000u
+#define SIM_ADC_HZ 48000000u
+#define SIM_ADC_CYCLES 96           // Ciclos mínimos por conversão
+#define SIM_ADC_FIFO_DEPTH 4
+#define SIM_USB_RX_SIZE 64
+
+// ---------------------------------------------------------------------------
+// GPIO
+
+#define SIM_GPIO_MAX_SWITCHES 16
+
+static struct {
+    bool out[NUM_BANK0_GPIOS];
+    bool out_value[NUM_BANK0_GPIOS];
+    bool pull_up[NUM_BANK0_GPIOS];
+    bool pull_down[NUM_BANK0_GPIOS];
+    bool external[NUM_BANK0_GPIOS];      // Nível imposto pelo roteiro/teste
+    bool external_level[NUM_BANK0_GPIOS];
+    uint32_t irq_mask[NUM_BANK0_GPIOS];
+    gpio_function_t function[NUM_BANK0_GPIOS];
+    uint8_t switches[SIM_GPIO_MAX_SWITCHES][2]; // Chaves fechadas entre dois pinos (teclado matricial)
+    uint num_switches;
+} gpio;
+
+static bool gpio_driven(uint pin) {
+    return gpio.out[pin] && gpio.function[pin] == GPIO_FUNC_SIO;
+}
+
+bool gpio_get(uint pin) {
+    if (pin >= NUM_BANK0_GPIOS)
+        return false;
+    if (gpio_driven(pin))
+        return gpio.out_value[pin];
+    if (gpio.external[pin])
+        return gpio.external_level[pin];
+    // Entrada ligada por uma chave fechada a um pino que é saída segue esse pino
+    // (um nível só: chaves em série, como os fantasmas do teclado, não passam)
+    for (uint i = 0; i < gpio.num_switches; i++) {
+        uint other = gpio.switches[i][0] == pin ? gpio.switches[i][1]
+                   : gpio.switches[i][1] == pin ? gpio.switches[i][0] : NUM_BANK0_GPIOS;
+        if (other < NUM_BANK0_GPIOS && gpio_driven(other))
+            return gpio.out_value[other];
+    }
+    return gpio.pull_up[pin];
+}
+
+uint32_t gpio_get_all(void) {
+    uint32_t levels = 0;
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+        levels |= (uint32_t)gpio_get(pin) << pin;
+    return levels;
+}
+
+// Depois de uma alteração, gera as IRQs de borda de todos os pinos que mudaram
+// (uma chave fechada propaga a mudança de um pino para outro)
+static void gpio_update(uint32_t before) {
+    uint32_t after = gpio_get_all();
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        if (!((before ^ after) & (1u << pin)))
+            continue;
+        uint32_t event = after & (1u << pin) ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+        if (gpio.irq_mask[pin] & event)
+            sim_irq_gpio(pin, event);
+    }
+}
+
+void gpio_init(uint pin) {
+    uint32_t before = gpio_get_all();
+    gpio.out[pin] = false;
+    gpio.out_value[pin] = false;
+    gpio.function[pin] = GPIO_FUNC_SIO;
+    gpio_update(before);
+}
+
+void gpio_set_dir(uint pin, bool out) {
+    uint32_t before = gpio_get_all();
+    gpio.out[pin] = out;
+    gpio_update(before);
+}
+
+void gpio_set_dir_masked(uint32_t mask, uint32_t value) {
+    uint32_t before = gpio_get_all();
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+        if (mask & (1u << pin))
+            gpio.out[pin] = (value >> pin) & 1u;
+    gpio_update(before);
+}
+
+void gpio_set_function(uint pin, gpio_function_t fn) {
+    uint32_t before = gpio_get_all();
+    gpio.function[pin] = fn;
+    gpio_update(before);
+}
+
+void gpio_pull_up(uint pin) {
+    uint32_t before = gpio_get_all();
+    gpio.pull_up[pin] = true;
+    gpio.pull_down[pin] = false;
+    gpio_update(before);
+}
+
+void gpio_pull_down(uint pin) {
+    uint32_t before = gpio_get_all();
+    gpio.pull_up[pin] = false;
+    gpio.pull_down[pin] = true;
+    gpio_update(before);
+}
+
+void gpio_disable_pulls(uint pin) {
+    uint32_t before = gpio_get_all();
+    gpio.pull_up[pin] = gpio.pull_down[pin] = false;
+    gpio_update(before);
+}
+
+void gpio_set_drive_strength(uint pin, enum gpio_drive_strength drive) {
+    (void)pin;
+    (void)drive;
+}
+
+void gpio_set_slew_rate(uint pin, enum gpio_slew_rate slew) {
+    (void)pin;
+    (void)slew;
+}
+
+void gpio_put(uint pin, bool value) {
+    uint32_t before = gpio_get_all();
+    gpio.out_value[pin] = value;
+    gpio_update(before);
+}
+
+void gpio_set_irq_enabled(uint pin, uint32_t event_mask, bool enabled) {
+    if (enabled)
+        gpio.irq_mask[pin] |= event_mask;
+    else
+        gpio.irq_mask[pin] &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint pin, uint32_t event_mask, bool enabled,
+                                        gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(pin, event_mask, enabled);
+    sim_irq_set_gpio_callback(callback);
+}
+
+void gpio_set_irq_callback(gpio_irq_callback_t callback) {
+    sim_irq_set_gpio_callback(callback);
+}
+
+void sim_gpio_set_input(uint pin, bool level) {
+    uint32_t before = gpio_get_all();
+    gpio.external[pin] = true;
+    gpio.external_level[pin] = level;
+    gpio_update(before);
+}
+
+void sim_gpio_release_input(uint pin) {
+    uint32_t before = gpio_get_all();
+    gpio.external[pin] = false;
+    gpio_update(before);
+}
+
+void sim_gpio_switch(uint a, uint b, bool closed) {
+    uint32_t before = gpio_get_all();
+    for (uint i = 0; i < gpio.num_switches; i++) {
+        if ((gpio.switches[i][0] == a && gpio.switches[i][1] == b) ||
+            (gpio.switches[i][0] == b && gpio.switches[i][1] == a)) {
+            if (!closed)
+                memcpy(gpio.switches[i], gpio.switches[--gpio.num_switches], sizeof(gpio.switches[i]));
+            gpio_update(before);
+            return;
+        }
+    }
+    if (closed && gpio.num_switches < SIM_GPIO_MAX_SWITCHES) {
+        gpio.switches[gpio.num_switches][0] = (uint8_t)a;
+        gpio.switches[gpio.num_switches][1] = (uint8_t)b;
+        gpio.num_switches++;
+    }
+    gpio_update(before);
+}
+
+bool sim_gpio_output(uint pin) {
+    return gpio.out_value[pin];
+}
+
+// ---------------------------------------------------------------------------
+// I2C: o SSD1306 virtual fica em ssd1306_hal_mock.c; aqui só o clock do barramento
+
+static struct i2c_inst {
+    uint baudrate;
+} i2c_instances[2];
+
+i2c_inst_t *const host_i2c0 = &i2c_instances[0];
+i2c_inst_t *const host_i2c1 = &i2c_instances[1];
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate > 1000000 ? 1000000 : baudrate;
+    ssd1306_hal_mock_set_bus_hz(i2c->baudrate);
+    return i2c->baudrate;
+}
+
+void i2c_deinit(i2c_inst_t *i2c) {
+    i2c->baudrate = 0;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c;
+    (void)addr;
+    (void)src;
+    (void)nostop;
+    return (int)len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    (void)i2c;
+    (void)addr;
+    (void)nostop;
+    memset(dst, 0, len);
+    return (int)len;
+}
+
+// ---------------------------------------------------------------------------
+// DMA
+
+static dma_hw_t dma_regs;
+dma_hw_t *const dma_hw = &dma_regs;
+
+static struct {
+    bool claimed;
+    bool busy;
+    uintptr_t reload;   // TRANS_COUNT escrito: recarregado a cada disparo
+    uint32_t ctrl;
+} dma_ch[NUM_DMA_CHANNELS];
+
+// Campos de dma_channel_config.ctrl
+#define CTRL_SIZE(c) ((c) & 0x3u)
+#define CTRL_INCR_READ (1u << 2)
+#define CTRL_INCR_WRITE (1u << 3)
+#define CTRL_DREQ(c) (((c) >> 4) & 0x3fu)
+#define CTRL_CHAIN(c) (((c) >> 10) & 0xfu)
+
+int dma_claim_unused_channel(bool required) {
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!dma_ch[ch].claimed) {
+            dma_ch[ch].claimed = true;
+            return (int)ch;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "sim: nenhum canal de DMA livre\n");
+        sim_exit(1);
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    dma_ch[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    return (dma_channel_config){DMA_SIZE_32 | CTRL_INCR_READ | (DREQ_FORCE << 4) | (channel << 10)};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->ctrl = (c->ctrl & ~0x3u) | size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | CTRL_INCR_READ : c->ctrl & ~CTRL_INCR_READ;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | CTRL_INCR_WRITE : c->ctrl & ~CTRL_INCR_WRITE;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->ctrl = (c->ctrl & ~(0x3fu << 4)) | ((dreq & 0x3fu) << 4);
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->ctrl = (c->ctrl & ~(0xfu << 10)) | ((chain_to & 0xfu) << 10);
+}
+
+static void dma_run_unpaced(uint ch);
+
+static bool is_pio_tx_dreq(uint dreq) {
+    return dreq < DREQ_PIO1_TX0 + 8 && dreq % 8 < 4;
+}
+
+static void dma_trigger(uint ch) {
+    dma_ch[ch].busy = dma_ch[ch].reload > 0;
+    dma_regs.ch[ch].transfer_count = dma_ch[ch].reload;
+    if (!dma_ch[ch].busy)
+        return;
+    if (CTRL_DREQ(dma_ch[ch].ctrl) == DREQ_FORCE)
+        dma_run_unpaced(ch);
+    else if (is_pio_tx_dreq(CTRL_DREQ(dma_ch[ch].ctrl)))
+        sim_pio_advance(sim_now_us() * 1000); // Enche o FIFO na hora
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    dma_ch[channel].ctrl = config->ctrl;
+    dma_ch[channel].reload = transfer_count;
+    dma_regs.ch[channel].read_addr = (uintptr_t)read_addr;
+    dma_regs.ch[channel].write_addr = (uintptr_t)write_addr;
+    dma_regs.ch[channel].transfer_count = transfer_count;
+    if (trigger)
+        dma_trigger(channel);
+}
+
+void dma_channel_start(uint channel) {
+    dma_trigger(channel);
+}
+
+void dma_channel_abort(uint channel) {
+    dma_ch[channel].busy = false;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return dma_ch[channel].busy;
+}
+
+// Escrita de um canal de DMA nos registradores de outro canal (canal de controle).
+// Os apelidos seguem a ordem do RP2040: o último registrador de cada grupo dispara.
+static void dma_register_write(uintptr_t addr, uintptr_t value) {
+    uintptr_t offset = addr - (uintptr_t)&dma_regs;
+    uint ch = offset / sizeof(dma_channel_hw_t);
+    uint reg = (offset % sizeof(dma_channel_hw_t)) / sizeof(uintptr_t);
+    static const uint8_t kind[16] = {0, 1, 2, 3, 3, 0, 1, 2, 3, 2, 0, 1, 3, 1, 2, 0}; // read, write, count, ctrl
+    volatile uintptr_t *regs = (volatile uintptr_t *)&dma_regs.ch[ch];
+    regs[reg] = value;
+    switch (kind[reg]) {
+        case 0: dma_regs.ch[ch].read_addr = value; break;
+        case 1: dma_regs.ch[ch].write_addr = value; break;
+        case 2: dma_ch[ch].reload = value; break;
+        default: break;
+    }
+    if (reg % 4 == 3)
+        dma_trigger(ch);
+}
+
+static bool is_dma_register(uintptr_t addr) {
+    return addr >= (uintptr_t)&dma_regs && addr < (uintptr_t)(&dma_regs + 1);
+}
+
+// Uma transferência do canal; value_in, se não nulo, substitui a leitura (FIFO do ADC)
+static void dma_transfer(uint ch, const uint32_t *value_in) {
+    dma_channel_hw_t *r = &dma_regs.ch[ch];
+    uint32_t ctrl = dma_ch[ch].ctrl;
+    size_t size = 1u << CTRL_SIZE(ctrl);
+
+    if (is_dma_register(r->write_addr)) {
+        // Registradores de endereço têm a largura de um ponteiro do host
+        uintptr_t value = 0;
+        memcpy(&value, (const void *)r->read_addr, size < sizeof(value) ? sizeof(value) : size);
+        dma_register_write(r->write_addr, value);
+    } else {
+        uint32_t value = 0;
+        if (value_in)
+            value = *value_in;
+        else
+            memcpy(&value, (const void *)r->read_addr, size);
+        if (!sim_pio_txf_write(r->write_addr, value))
+            memcpy((void *)r->write_addr, &value, size);
+    }
+
+    if (ctrl & CTRL_INCR_READ)
+        r->read_addr += size;
+    if (ctrl & CTRL_INCR_WRITE)
+        r->write_addr += size;
+    if (--r->transfer_count == 0) {
+        dma_ch[ch].busy = false;
+        uint chain = CTRL_CHAIN(ctrl);
+        if (chain != ch)
+            dma_trigger(chain);
+    }
+}
+
+static void dma_run_unpaced(uint ch) {
+    while (dma_ch[ch].busy)
+        dma_transfer(ch, NULL);
+}
+
+// Um periférico sinalizou DREQ com um dado pronto; retorna false se nenhum canal o consumiu
+static bool dma_dreq(uint dreq, uintptr_t source, uint32_t value) {
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (dma_ch[ch].busy && CTRL_DREQ(dma_ch[ch].ctrl) == dreq && dma_regs.ch[ch].read_addr == source) {
+            dma_transfer(ch, &value);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Um periférico que recebe dados (FIFO de TX da PIO) pediu uma palavra; false
+// se nenhum canal ocupado atende esse DREQ
+bool sim_dma_dreq(uint dreq) {
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (dma_ch[ch].busy && CTRL_DREQ(dma_ch[ch].ctrl) == dreq) {
+            dma_transfer(ch, NULL);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// ADC
+
+static adc_hw_t adc_regs;
+adc_hw_t *const adc_hw = &adc_regs;
+
+static struct {
+    uint16_t value[5];
+    uint selected;
+    uint round_robin;
+    bool fifo_enabled, dreq_enabled, running, temp_sensor;
+    float clkdiv;
+    uint64_t next_sample_ns;
+    uint16_t fifo[SIM_ADC_FIFO_DEPTH];
+    uint fifo_count;
+} adc;
+
+void sim_adc_set(uint channel, uint16_t value) {
+    if (channel < count_of(adc.value))
+        adc.value[channel] = value & 0x0fff;
+}
+
+static uint64_t adc_period_ns(void) {
+    float cycles = adc.clkdiv + 1.0f;
+    if (cycles < SIM_ADC_CYCLES)
+        cycles = SIM_ADC_CYCLES;
+    return (uint64_t)(cycles * 1e9f / SIM_ADC_HZ);
+}
+
+// Conversão do canal selecionado; o round-robin passa ao próximo canal da máscara
+static uint16_t adc_convert(void) {
+    uint16_t value = adc.value[adc.selected];
+    if (adc.round_robin) {
+        for (uint i = 1; i <= 5; i++) {
+            uint next = (adc.selected + i) % 5;
+            if (adc.round_robin & (1u << next)) {
+                adc.selected = next;
+                break;
+            }
+        }
+    }
+    return value;
+}
+
+void adc_init(void) {
+    adc.running = adc.fifo_enabled = adc.dreq_enabled = false;
+    adc.round_robin = 0;
+    adc.fifo_count = 0;
+    adc.clkdiv = 0;
+}
+
+void adc_gpio_init(uint pin) {
+    gpio_disable_pulls(pin);
+    gpio.function[pin] = GPIO_FUNC_NULL;
+}
+
+void adc_select_input(uint input) {
+    adc.selected = input % 5;
+}
+
+uint adc_get_selected_input(void) {
+    return adc.selected;
+}
+
+uint16_t adc_read(void) {
+    busy_wait_us(2); // 96 ciclos a 48 MHz
+    return adc_convert();
+}
+
+void adc_set_round_robin(uint input_mask) {
+    adc.round_robin = input_mask & 0x1f;
+}
+
+void adc_set_temp_sensor_enabled(bool enable) {
+    adc.temp_sensor = enable;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)dreq_thresh;
+    (void)err_in_fifo;
+    (void)byte_shift;
+    adc.fifo_enabled = en;
+    adc.dreq_enabled = dreq_en;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    adc.clkdiv = clkdiv;
+}
+
+void adc_run(bool run) {
+    adc.running = run;
+    adc.next_sample_ns = sim_now_us() * 1000 + adc_period_ns();
+}
+
+void adc_fifo_drain(void) {
+    adc.fifo_count = 0;
+}
+
+static void adc_advance(uint64_t to_us) {
+    if (!adc.running)
+        return;
+    uint64_t period = adc_period_ns();
+    while (adc.next_sample_ns <= to_us * 1000) {
+        uint16_t sample = adc_convert();
+        adc.next_sample_ns += period;
+        if (!adc.fifo_enabled)
+            continue;
+        if (adc.dreq_enabled && dma_dreq(DREQ_ADC, (uintptr_t)&adc_regs.fifo, sample))
+            continue;
+        if (adc.fifo_count < SIM_ADC_FIFO_DEPTH)
+            adc.fifo[adc.fifo_count++] = sample;
+        adc_regs.fifo = adc.fifo[0];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Clocks, stdio e bootrom
+
+static uint32_t sys_hz = SIM_SYS_HZ;
+
+void sim_set_sys_hz(uint32_t hz) {
+    sys_hz = hz;
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index == clk_adc || clk_index == clk_usb ? SIM_ADC_HZ : sys_hz;
+}
+
+bool stdio_init_all(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return true;
+}
+
+// Serial USB: só a recepção, alimentada pelo roteiro; a espera não é simulada
+static struct {
+    char data[SIM_USB_RX_SIZE];
+    uint head, tail;
+} usb_rx;
+
+void sim_usb_input(const char *text) {
+    for (; *text; text++) {
+        if (usb_rx.head - usb_rx.tail == SIM_USB_RX_SIZE)
+            return;
+        usb_rx.data[usb_rx.head++ % SIM_USB_RX_SIZE] = *text;
+    }
+}
+
+int putchar_raw(int c) {
+    return putchar(c);
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    (void)timeout_us;
+    if (usb_rx.head == usb_rx.tail)
+        return PICO_ERROR_TIMEOUT;
+    return (unsigned char)usb_rx.data[usb_rx.tail++ % SIM_USB_RX_SIZE];
+}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask) {
+    (void)usb_activity_gpio_pin_mask;
+    (void)disable_interface_mask;
+    printf("sim: reset_usb_boot (BOOTSEL), fim da simulacao\n");
+    sim_exit(0);
+}
+
+// ---------------------------------------------------------------------------
+
+void sim_periph_init(void) {
+    memset(&gpio, 0, sizeof(gpio));
+    memset(&adc, 0, sizeof(adc));
+    memset(dma_ch, 0, sizeof(dma_ch));
+    memset(&dma_regs, 0, sizeof(dma_regs));
+    sim_pio_init();
+    memset(&usb_rx, 0, sizeof(usb_rx));
+    // Joystick em repouso e sensor de temperatura a ~27 °C (0,706 V)
+    adc.value[0] = adc.value[1] = 2048;
+    adc.value[2] = adc.value[3] = 0;
+    adc.value[4] = 876;
+}
+
+void sim_periph_advance(uint64_t from_us, uint64_t to_us) {
+    (void)from_us;
+    adc_advance(to_us);
+    sim_pio_advance(to_us * 1000);
+}
+
+const uint8_t *sim_oled_ram(void) {
+    return ssd1306_hal_mock_panel();
+}
+
+bool sim_oled_display(uint8_t *contrast) {
+    if (contrast)
+        *contrast = ssd1306_hal_mock_contrast();
+    return ssd1306_hal_mock_display_on();
+}
+
+uint8_t sim_oled_start_line(void) {
+    return ssd1306_hal_mock_start_line();
+}
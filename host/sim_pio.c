@@ -0,0 +1,415 @@
+#include <string.h>
+#include "sim_internal.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/pio.h"
+
+// PIO simulada ciclo a ciclo e fita WS2812 virtual.
+//
+// Cada máquina de estados guarda o instante do próximo ciclo em ciclos de
+// clk_sys; um ciclo da PIO dura a parte inteira do divisor, mais um ciclo de
+// clk_sys quando o acumulador da fração estoura (o mesmo jitter do RP2040).
+// As máquinas só rodam quando o tempo simulado avança (sim_pio_advance); paradas
+// num out/pull com o FIFO vazio, saltam direto para o fim do intervalo.
+//
+// A fita decodifica as bordas do pino pela largura do pulso em nível alto, como
+// o WS2812B: acima de SIM_WS2812_T1_NS é um bit 1. Nível baixo por
+// SIM_WS2812_RESET_NS trava o quadro e a próxima borda recomeça do primeiro LED.
+
+#define SIM_PIO_FIFO_DEPTH 4
+#define SIM_WS2812_T1_NS 600        // Entre T0H máximo (550 ns) e T1H mínimo (650 ns)
+#define SIM_WS2812_RESET_NS 50000   // Linha em nível baixo por 50 us: a fita trava o quadro
+
+// Campos da instrução
+#define OP(ins) ((ins) >> 13)
+#define DELAY_SIDE(ins) (((ins) >> 8) & 0x1fu)
+#define ARG1(ins) (((ins) >> 5) & 0x7u)
+#define ARG2(ins) ((ins) & 0x1fu)
+
+enum { OP_JMP, OP_WAIT, OP_IN, OP_OUT, OP_PUSH_PULL, OP_MOV, OP_IRQ, OP_SET };
+
+#define NOP 0xa042u // mov y, y
+
+typedef struct {
+    uint pc;
+    uint32_t x, y, osr;
+    uint osr_count;             // Bits já deslocados do OSR (>= limiar: vazio)
+    uint32_t fifo[2 * SIM_PIO_FIFO_DEPTH];
+    uint fifo_head, fifo_count, fifo_depth;
+    uint delay;                 // Ciclos de atraso da última instrução
+    uint div_int, div_frac, frac_acc;
+    uint64_t cycle;             // Instante do próximo ciclo, em ciclos de clk_sys
+} sm_state_t;
+
+static pio_hw_t pio_instances[2];
+pio_hw_t *const host_pio0 = &pio_instances[0];
+pio_hw_t *const host_pio1 = &pio_instances[1];
+static sm_state_t sm_states[2][4];
+static bool pins[NUM_BANK0_GPIOS];  // Níveis impostos pela PIO
+static uint64_t write_cycle;        // Instante das escritas da DMA durante sim_pio_advance
+static bool running;
+
+static struct {
+    sim_edge_t *edges;
+    uint max, count;
+} capture;
+
+static struct {
+    sim_rgb_t leds[SIM_LED_MAX];
+    uint count;             // LEDs recebidos no maior quadro até agora
+    uint position;          // LED que recebe os próximos bits
+    uint32_t bits;          // Bits do LED em montagem (GRB, MSB primeiro)
+    uint nbits;
+    uint64_t rise_ns, fall_ns;
+} strip;
+
+static uint pio_index(PIO pio) {
+    return pio == host_pio1 ? 1 : 0;
+}
+
+static uint64_t ns_to_cycles(uint64_t ns) {
+    return (uint64_t)((double)ns * clock_get_hz(clk_sys) / 1e9);
+}
+
+static uint64_t cycles_to_ns(uint64_t cycles) {
+    return (uint64_t)((double)cycles * 1e9 / clock_get_hz(clk_sys));
+}
+
+static void __attribute__((noreturn)) pio_fail(PIO pio, uint sm, const char *msg) {
+    const sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    fprintf(stderr, "sim: pio%u sm%u pc %u (0x%04x): %s\n", pio_index(pio), sm, s->pc, pio->instr_mem[s->pc], msg);
+    sim_exit(1);
+}
+
+// ---------------------------------------------------------------------------
+// Fita WS2812
+
+static void strip_edge(bool level, uint64_t t_ns) {
+    if (level) {
+        if (t_ns - strip.fall_ns >= SIM_WS2812_RESET_NS) {
+            strip.position = 0;
+            strip.nbits = 0;
+        }
+        strip.rise_ns = t_ns;
+        return;
+    }
+    strip.fall_ns = t_ns;
+    strip.bits = (strip.bits << 1) | (t_ns - strip.rise_ns > SIM_WS2812_T1_NS);
+    if (++strip.nbits < 24)
+        return;
+    if (strip.position < SIM_LED_MAX) {
+        strip.leds[strip.position] = (sim_rgb_t){
+            .r = (uint8_t)(strip.bits >> 8), .g = (uint8_t)(strip.bits >> 16), .b = (uint8_t)strip.bits};
+        strip.position++;
+        if (strip.position > strip.count)
+            strip.count = strip.position;
+    }
+    strip.bits = 0;
+    strip.nbits = 0;
+}
+
+const sim_rgb_t *sim_leds(uint *count) {
+    if (count)
+        *count = strip.count;
+    return strip.leds;
+}
+
+// ---------------------------------------------------------------------------
+// Pinos
+
+static void pin_write(uint pin, bool level, uint64_t cycle) {
+    if (pin >= NUM_BANK0_GPIOS || pins[pin] == level)
+        return;
+    pins[pin] = level;
+    uint64_t t_ns = cycles_to_ns(cycle);
+    if (capture.edges && capture.count < capture.max)
+        capture.edges[capture.count++] = (sim_edge_t){t_ns, (uint8_t)pin, level};
+    strip_edge(level, t_ns);
+}
+
+static void pins_write(uint base, uint count, uint32_t value, uint64_t cycle) {
+    for (uint i = 0; i < count; i++)
+        pin_write((base + i) % NUM_BANK0_GPIOS, (value >> i) & 1u, cycle);
+}
+
+void sim_pio_capture(sim_edge_t *edges, uint max) {
+    capture.edges = edges;
+    capture.max = edges ? max : 0;
+    capture.count = 0;
+}
+
+uint sim_pio_captured(void) {
+    return capture.count;
+}
+
+// ---------------------------------------------------------------------------
+// Máquina de estados
+
+static bool fifo_pop(sm_state_t *s, uint32_t *value) {
+    if (s->fifo_count == 0)
+        return false;
+    *value = s->fifo[s->fifo_head];
+    s->fifo_head = (s->fifo_head + 1) % s->fifo_depth;
+    s->fifo_count--;
+    return true;
+}
+
+static bool fifo_push(sm_state_t *s, uint32_t value) {
+    if (s->fifo_count == s->fifo_depth)
+        return false; // Como no RP2040: a escrita num FIFO cheio se perde
+    s->fifo[(s->fifo_head + s->fifo_count) % s->fifo_depth] = value;
+    s->fifo_count++;
+    return true;
+}
+
+// Executa a instrução em s->pc; false se ela parou (FIFO vazio)
+static bool sm_step(PIO pio, uint sm) {
+    sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    const pio_sm_config *c = &pio->config[sm];
+    uint16_t ins = pio->instr_mem[s->pc];
+    uint delay_bits = 5 - c->sideset_bits;
+    uint side = DELAY_SIDE(ins) >> delay_bits;
+    uint next = s->pc == c->wrap ? c->wrap_target : (s->pc + 1) % PIO_INSTRUCTION_COUNT;
+
+    // O side-set vale desde o primeiro ciclo, mesmo com a instrução parada
+    if (c->sideset_bits) {
+        uint data_bits = c->sideset_bits - (c->sideset_optional ? 1 : 0);
+        if (!c->sideset_optional || (side >> data_bits) & 1u)
+            pins_write(c->sideset_base, data_bits, side, s->cycle);
+    }
+
+    switch (OP(ins)) {
+        case OP_JMP: {
+            bool taken;
+            switch (ARG1(ins)) {
+                case 0: taken = true; break;
+                case 1: taken = s->x == 0; break;
+                case 2: taken = s->x-- != 0; break;
+                case 3: taken = s->y == 0; break;
+                case 4: taken = s->y-- != 0; break;
+                case 5: taken = s->x != s->y; break;
+                case 7: taken = s->osr_count < c->pull_threshold; break;
+                default: pio_fail(pio, sm, "jmp pin não suportado");
+            }
+            if (taken)
+                next = ARG2(ins);
+            break;
+        }
+        case OP_OUT: {
+            uint n = ARG2(ins) ? ARG2(ins) : 32;
+            if (c->autopull && s->osr_count >= c->pull_threshold) {
+                if (!fifo_pop(s, &s->osr))
+                    return false;
+                s->osr_count = 0;
+            }
+            uint32_t data;
+            if (c->out_shift_right) {
+                data = n == 32 ? s->osr : s->osr & ((1u << n) - 1);
+                s->osr = n == 32 ? 0 : s->osr >> n;
+            } else {
+                data = n == 32 ? s->osr : s->osr >> (32 - n);
+                s->osr = n == 32 ? 0 : s->osr << n;
+            }
+            s->osr_count = s->osr_count + n > 32 ? 32 : s->osr_count + n;
+            switch (ARG1(ins)) {
+                case 0: pins_write(c->out_base, c->out_count, data, s->cycle); break;
+                case 1: s->x = data; break;
+                case 2: s->y = data; break;
+                case 3: break;          // null
+                case 4: break;          // pindirs: os pinos da PIO já são saídas
+                case 5: next = data % PIO_INSTRUCTION_COUNT; break;
+                default: pio_fail(pio, sm, "destino de out não suportado");
+            }
+            break;
+        }
+        case OP_PUSH_PULL: {
+            if (!(ins & 0x80u))
+                pio_fail(pio, sm, "push não suportado (sem FIFO de RX)");
+            bool if_empty = ins & 0x40u, block = ins & 0x20u;
+            if (if_empty && s->osr_count < c->pull_threshold)
+                break;
+            if (!fifo_pop(s, &s->osr)) {
+                if (block)
+                    return false;
+                s->osr = s->x;
+            }
+            s->osr_count = 0;
+            break;
+        }
+        case OP_SET:
+            switch (ARG1(ins)) {
+                case 0: pins_write(c->set_base, c->set_count, ARG2(ins), s->cycle); break;
+                case 1: s->x = ARG2(ins); break;
+                case 2: s->y = ARG2(ins); break;
+                case 4: break;          // pindirs
+                default: pio_fail(pio, sm, "destino de set não suportado");
+            }
+            break;
+        case OP_MOV:
+            if ((ins & 0xe0ffu) != NOP)
+                pio_fail(pio, sm, "mov não suportado (só nop)");
+            break;
+        default:
+            pio_fail(pio, sm, "instrução não suportada");
+    }
+    s->pc = next;
+    s->delay = DELAY_SIDE(ins) & ((1u << delay_bits) - 1);
+    return true;
+}
+
+// n ciclos da PIO em ciclos de clk_sys
+static void sm_tick(sm_state_t *s, uint n) {
+    uint acc = s->frac_acc + n * s->div_frac;
+    s->cycle += (uint64_t)n * s->div_int + acc / 256;
+    s->frac_acc = acc % 256;
+}
+
+// DREQ do FIFO de TX: a DMA escreve enquanto houver espaço
+static void sm_service_dreq(PIO pio, uint sm) {
+    sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    write_cycle = s->cycle;
+    while (s->fifo_count < s->fifo_depth && sim_dma_dreq(pio_get_dreq(pio, sm, true)))
+        ;
+}
+
+static void sm_run(PIO pio, uint sm, uint64_t to_cycle) {
+    sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    while (s->cycle < to_cycle && pio->enabled[sm]) {
+        if (s->delay) {
+            sm_tick(s, s->delay);
+            s->delay = 0;
+            continue;
+        }
+        sm_service_dreq(pio, sm);
+        if (sm_step(pio, sm)) {
+            sm_tick(s, 1);
+        } else if (s->fifo_count == 0) {
+            s->cycle = to_cycle; // Parada até chegar uma palavra
+        }
+    }
+}
+
+void sim_pio_advance(uint64_t to_ns) {
+    if (running)
+        return; // DMA disparada de dentro da própria simulação: o laço externo atende
+    running = true;
+    uint64_t to_cycle = ns_to_cycles(to_ns);
+    for (uint i = 0; i < count_of(pio_instances); i++) {
+        for (uint sm = 0; sm < 4; sm++) {
+            if (pio_instances[i].enabled[sm])
+                sm_run(&pio_instances[i], sm, to_cycle);
+        }
+    }
+    running = false;
+}
+
+// Escrita da DMA em txf[sm] de uma PIO; false se o endereço não é um FIFO
+bool sim_pio_txf_write(uintptr_t addr, uint32_t value) {
+    for (uint i = 0; i < count_of(pio_instances); i++) {
+        PIO pio = &pio_instances[i];
+        if (addr >= (uintptr_t)&pio->txf[0] && addr < (uintptr_t)&pio->txf[4]) {
+            uint sm = (addr - (uintptr_t)&pio->txf[0]) / sizeof(pio->txf[0]);
+            sm_state_t *s = &sm_states[i][sm];
+            if (running && s->cycle < write_cycle)
+                s->cycle = write_cycle;
+            fifo_push(s, value);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// API do SDK
+
+// Carrega em sequência e reloca os destinos dos jmp, como o pio_add_program do SDK
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    uint offset = program->origin >= 0 ? (uint)program->origin : pio->program_offset;
+    if (offset + program->length > PIO_INSTRUCTION_COUNT) {
+        fprintf(stderr, "sim: programa PIO não cabe na memória de instruções\n");
+        sim_exit(1);
+    }
+    for (uint i = 0; i < program->length; i++) {
+        uint16_t ins = program->instructions[i];
+        pio->instr_mem[offset + i] = OP(ins) == OP_JMP ? (uint16_t)(ins + offset) : ins;
+    }
+    pio->program_offset = offset + program->length;
+    return offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    for (uint sm = 0; sm < 4; sm++) {
+        if (!pio->claimed[sm]) {
+            pio->claimed[sm] = true;
+            return (int)sm;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "sim: nenhuma maquina de estados PIO livre\n");
+        sim_exit(1);
+    }
+    return -1;
+}
+
+void pio_gpio_init(PIO pio, uint pin) {
+    gpio_set_function(pin, pio == host_pio0 ? GPIO_FUNC_PIO0 : GPIO_FUNC_PIO1);
+}
+
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+    (void)pio;
+    (void)sm;
+    for (uint i = 0; i < pin_count; i++)
+        gpio_set_dir(pin_base + i, is_out);
+}
+
+pio_sm_config pio_get_default_sm_config(void) {
+    return (pio_sm_config){.wrap = 31, .clkdiv = 1.0f, .out_shift_right = true, .pull_threshold = 32};
+}
+
+// Divisor em 16.8 bits, como o sm_config_set_clkdiv do SDK; OSR vazio e FIFO limpo
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    pio->config[sm] = *config;
+    pio->enabled[sm] = false;
+    sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    uint div_int = config->clkdiv >= 1.0f ? (uint)config->clkdiv : 1;
+    *s = (sm_state_t){
+        .pc = initial_pc % PIO_INSTRUCTION_COUNT,
+        .osr_count = 32,
+        .fifo_depth = config->fifo_join == PIO_FIFO_JOIN_TX ? 2 * SIM_PIO_FIFO_DEPTH : SIM_PIO_FIFO_DEPTH,
+        .div_int = div_int,
+        .div_frac = config->clkdiv >= 1.0f ? (uint)((config->clkdiv - (float)div_int) * 256.0f) : 0,
+    };
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    uint64_t now = ns_to_cycles(sim_now_us() * 1000);
+    if (enabled && !pio->enabled[sm] && s->cycle < now)
+        s->cycle = now;
+    pio->enabled[sm] = enabled;
+}
+
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm) {
+    sim_pio_advance(sim_now_us() * 1000);
+    const sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    return s->fifo_count == s->fifo_depth;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    while (pio_sm_is_tx_fifo_full(pio, sm))
+        busy_wait_us(1);
+    sm_state_t *s = &sm_states[pio_index(pio)][sm];
+    uint64_t now = ns_to_cycles(sim_now_us() * 1000);
+    if (s->cycle < now)
+        s->cycle = now; // Estava parada esperando o FIFO
+    fifo_push(s, data);
+}
+
+void sim_pio_init(void) {
+    memset(pio_instances, 0, sizeof(pio_instances));
+    memset(sm_states, 0, sizeof(sm_states));
+    memset(pins, 0, sizeof(pins));
+    memset(&strip, 0, sizeof(strip));
+    capture.count = 0;
+    running = false;
+}
@@ -0,0 +1,527 @@
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include "sim_internal.h"
+#include "ssd1306_hal.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+// Relógio virtual, agenda de eventos, interrupções do núcleo 0 e os dois núcleos.
+// O núcleo 1 é uma corrotina (ucontext) que o núcleo 0 executa até ela esperar.
+
+#define SIM_MAX_EVENTS 64
+#define SIM_MAX_IRQS 64
+#define SIM_MAX_ALARMS 16           // Alarmes de disparo único (add_alarm_in_us) ativos
+#define SIM_FIFO_DEPTH 8            // FIFO do SIO entre os núcleos
+#define SIM_CORE1_STACK (256 * 1024)
+#define SIM_CLOCK_READ_US 1         // Custo de uma leitura do relógio
+
+typedef struct {
+    uint64_t at_us;
+    sim_event_fn_t fn;
+    void *arg;
+    bool active;
+} event_t;
+
+typedef enum {
+    IRQ_GPIO,
+    IRQ_TIMER,
+    IRQ_ALARM,
+} irq_kind_t;
+
+typedef struct {
+    alarm_id_t id;      // 0 = livre
+    alarm_callback_t callback;
+    void *user_data;
+} alarm_t;
+
+typedef struct {
+    irq_kind_t kind;
+    uint gpio;
+    uint32_t events;
+    repeating_timer_t *timer;
+    alarm_t *alarm;
+    uint64_t at_us;     // Instante em que o alarme venceu
+} irq_t;
+
+typedef struct {
+    uint32_t data[SIM_FIFO_DEPTH];
+    uint head, count;
+} fifo_t;
+
+static struct {
+    uint64_t now_us;
+    bool advancing;
+    event_t events[SIM_MAX_EVENTS];
+
+    irq_t irqs[SIM_MAX_IRQS];
+    uint irq_head, irq_count;
+    bool irq_enabled[2];
+    bool in_irq;
+    gpio_irq_callback_t gpio_callback;
+    alarm_id_t next_alarm_id;
+    alarm_t alarms[SIM_MAX_ALARMS];
+
+    uint core;                  // Núcleo em execução
+    bool event_flag[2];         // Registrador de eventos do WFE/SEV
+    fifo_t fifo[2];             // fifo[n]: mensagens destinadas ao núcleo n
+
+    void (*core1_entry)(void);
+    bool core1_started, core1_finished, core1_waiting, core1_wait_event;
+    uint64_t core1_deadline;
+    ucontext_t core0_ctx, core1_ctx;
+    void *core1_stack;
+
+    void (*exit_handler)(int status);
+} sim;
+
+// ---------------------------------------------------------------------------
+// Agenda e relógio
+
+void sim_schedule(uint64_t at_us, sim_event_fn_t fn, void *arg) {
+    for (uint i = 0; i < SIM_MAX_EVENTS; i++) {
+        if (!sim.events[i].active) {
+            sim.events[i] = (event_t){at_us, fn, arg, true};
+            return;
+        }
+    }
+    fprintf(stderr, "sim: agenda cheia\n");
+    sim_exit(1);
+}
+
+static event_t *earliest_event(void) {
+    event_t *best = NULL;
+    for (uint i = 0; i < SIM_MAX_EVENTS; i++) {
+        event_t *e = &sim.events[i];
+        if (e->active && (!best || e->at_us < best->at_us))
+            best = e;
+    }
+    return best;
+}
+
+// Avança o relógio até t executando, em ordem, os eventos que vencem no caminho
+static void advance_to(uint64_t t) {
+    if (sim.advancing) { // Evento que lê o relógio: só avança, sem reentrar na agenda
+        if (t > sim.now_us) {
+            sim_periph_advance(sim.now_us, t);
+            sim.now_us = t;
+        }
+        return;
+    }
+    sim.advancing = true;
+    for (;;) {
+        event_t *e = earliest_event();
+        if (!e || e->at_us > t)
+            break;
+        if (e->at_us > sim.now_us) {
+            sim_periph_advance(sim.now_us, e->at_us);
+            sim.now_us = e->at_us;
+        }
+        e->active = false;
+        e->fn(e->arg);
+    }
+    if (t > sim.now_us) {
+        sim_periph_advance(sim.now_us, t);
+        sim.now_us = t;
+    }
+    sim.advancing = false;
+}
+
+uint64_t sim_now_us(void) {
+    return sim.now_us;
+}
+
+uint64_t time_us_64(void) {
+    advance_to(sim.now_us + SIM_CLOCK_READ_US);
+    return sim.now_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+// ---------------------------------------------------------------------------
+// Interrupções do núcleo 0
+
+static void raise_irq(irq_t irq) {
+    if (sim.irq_count == SIM_MAX_IRQS) {
+        fprintf(stderr, "sim: fila de interrupcoes cheia, IRQ descartada\n");
+        return;
+    }
+    sim.irqs[(sim.irq_head + sim.irq_count++) % SIM_MAX_IRQS] = irq;
+    sim.event_flag[0] = true; // Uma IRQ pendente também acorda o WFE
+}
+
+void sim_irq_gpio(uint gpio, uint32_t events) {
+    raise_irq((irq_t){.kind = IRQ_GPIO, .gpio = gpio, .events = events});
+}
+
+void sim_irq_set_gpio_callback(gpio_irq_callback_t callback) {
+    sim.gpio_callback = callback;
+}
+
+static void timer_expired(void *arg) {
+    repeating_timer_t *rt = arg;
+    raise_irq((irq_t){.kind = IRQ_TIMER, .timer = rt, .at_us = sim.now_us});
+}
+
+static void alarm_expired(void *arg) {
+    alarm_t *a = arg;
+    raise_irq((irq_t){.kind = IRQ_ALARM, .alarm = a, .at_us = sim.now_us});
+}
+
+static void run_alarm(alarm_t *a, uint64_t at_us) {
+    if (a->id == 0)
+        return; // Cancelado com a IRQ já pendente
+    int64_t again = a->callback(a->id, a->user_data);
+    if (again > 0)
+        sim_schedule(at_us + (uint64_t)again, alarm_expired, a);
+    else if (again < 0)
+        sim_schedule(sim.now_us + (uint64_t)-again, alarm_expired, a);
+    else
+        a->id = 0;
+}
+
+// Executa os tratadores pendentes; retorna true se algum rodou
+static bool deliver_irqs(void) {
+    if (sim.core != 0 || !sim.irq_enabled[0] || sim.in_irq)
+        return false;
+    bool delivered = false;
+    while (sim.irq_count) {
+        irq_t irq = sim.irqs[sim.irq_head];
+        sim.irq_head = (sim.irq_head + 1) % SIM_MAX_IRQS;
+        sim.irq_count--;
+        sim.in_irq = true;
+        if (irq.kind == IRQ_GPIO) {
+            if (sim.gpio_callback)
+                sim.gpio_callback(irq.gpio, irq.events);
+        } else if (irq.kind == IRQ_ALARM) {
+            run_alarm(irq.alarm, irq.at_us);
+        } else if (irq.timer->alarm_id >= 0) {
+            repeating_timer_t *rt = irq.timer;
+            bool again = rt->callback(rt);
+            if (again && rt->alarm_id >= 0) {
+                // Período negativo: entre inícios do callback; positivo: a partir do fim
+                uint64_t base = rt->delay_us < 0 ? irq.at_us : sim.now_us;
+                uint64_t period = (uint64_t)(rt->delay_us < 0 ? -rt->delay_us : rt->delay_us);
+                sim_schedule(base + period, timer_expired, rt);
+            } else {
+                rt->alarm_id = -1;
+            }
+        }
+        sim.in_irq = false;
+        delivered = true;
+    }
+    return delivered;
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    uint32_t status = sim.irq_enabled[sim.core];
+    sim.irq_enabled[sim.core] = false;
+    return status;
+}
+
+void restore_interrupts(uint32_t status) {
+    sim.irq_enabled[sim.core] = status != 0;
+    deliver_irqs();
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->alarm_id = ++sim.next_alarm_id;
+    uint64_t period = (uint64_t)(delay_us < 0 ? -delay_us : delay_us);
+    sim_schedule(sim.now_us + period, timer_expired, out);
+    return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    bool was_active = timer->alarm_id >= 0;
+    timer->alarm_id = -1;
+    for (uint i = 0; i < SIM_MAX_EVENTS; i++) {
+        if (sim.events[i].active && sim.events[i].fn == timer_expired && sim.events[i].arg == timer)
+            sim.events[i].active = false;
+    }
+    return was_active;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    (void)fire_if_past; // O relógio virtual não passa do alarme antes de agendá-lo
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        alarm_t *a = &sim.alarms[i];
+        if (a->id == 0) {
+            *a = (alarm_t){++sim.next_alarm_id, callback, user_data};
+            sim_schedule(sim.now_us + us, alarm_expired, a);
+            return a->id;
+        }
+    }
+    return -1; // Como no SDK: sem alarmes livres
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        alarm_t *a = &sim.alarms[i];
+        if (alarm_id > 0 && a->id == alarm_id) {
+            a->id = 0;
+            for (uint j = 0; j < SIM_MAX_EVENTS; j++) {
+                if (sim.events[j].active && sim.events[j].fn == alarm_expired && sim.events[j].arg == a)
+                    sim.events[j].active = false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Núcleos
+
+static void core1_trampoline(void) {
+    sim.core1_entry();
+    sim.core1_finished = true;
+    swapcontext(&sim.core1_ctx, &sim.core0_ctx);
+}
+
+static bool core1_runnable(void) {
+    if (!sim.core1_started || sim.core1_finished)
+        return false;
+    if (!sim.core1_waiting)
+        return true;
+    if (sim.core1_wait_event && sim.event_flag[1])
+        return true;
+    return sim.now_us >= sim.core1_deadline;
+}
+
+// Núcleo 0 cede a vez: o núcleo 1 roda até voltar a esperar
+static void run_core1(void) {
+    while (sim.core == 0 && core1_runnable()) {
+        sim.core = 1;
+        swapcontext(&sim.core0_ctx, &sim.core1_ctx);
+        sim.core = 0;
+    }
+}
+
+// Núcleo 1 espera até deadline ou, com on_event, até um SEV
+static void core1_wait(uint64_t deadline, bool on_event) {
+    if (on_event && sim.event_flag[1]) {
+        sim.event_flag[1] = false;
+        return;
+    }
+    sim.core1_waiting = true;
+    sim.core1_wait_event = on_event;
+    sim.core1_deadline = deadline;
+    swapcontext(&sim.core1_ctx, &sim.core0_ctx);
+    sim.core1_waiting = false;
+    if (on_event)
+        sim.event_flag[1] = false;
+}
+
+// Núcleo 0 ocioso até deadline, rodando o núcleo 1 e as interrupções no caminho.
+// Retorna antes se uma interrupção for tratada (ou ficar pendente, com IRQs
+// mascaradas) e wake_on_irq, ou se houver evento e wake_on_event.
+static void core0_idle(uint64_t deadline, bool wake_on_irq, bool wake_on_event) {
+    for (;;) {
+        run_core1();
+        bool irq = deliver_irqs() || sim.irq_count > 0;
+        if (wake_on_irq && irq)
+            return;
+        if (wake_on_event && sim.event_flag[0]) {
+            sim.event_flag[0] = false;
+            return;
+        }
+        if (sim.now_us >= deadline)
+            return;
+
+        uint64_t next = deadline;
+        event_t *e = earliest_event();
+        if (e && e->at_us < next)
+            next = e->at_us;
+        if (sim.core1_started && !sim.core1_finished && sim.core1_deadline < next)
+            next = sim.core1_deadline;
+        if (next == SIM_NEVER) {
+            fprintf(stderr, "sim: nenhum evento futuro, encerrando\n");
+            sim_exit(0);
+        }
+        advance_to(next > sim.now_us ? next : sim.now_us);
+    }
+}
+
+uint get_core_num(void) {
+    return sim.core;
+}
+
+void sim_run_for_us(uint64_t us) {
+    sleep_us(us);
+}
+
+void sleep_until(absolute_time_t t) {
+    if (sim.core == 0)
+        core0_idle(t, false, false);
+    else
+        core1_wait(t, false);
+}
+
+void sleep_us(uint64_t us) {
+    sleep_until(sim.now_us + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000);
+}
+
+// Espera ativa: no núcleo 0 as interrupções e o núcleo 1 continuam rodando,
+// como no hardware; no núcleo 1 o tempo apenas passa
+void busy_wait_us(uint64_t us) {
+    if (sim.core == 0)
+        core0_idle(sim.now_us + us, false, false);
+    else
+        advance_to(sim.now_us + us);
+}
+
+void busy_wait_us_32(uint32_t us) {
+    busy_wait_us(us);
+}
+
+void busy_wait_ms(uint32_t ms) {
+    busy_wait_us((uint64_t)ms * 1000);
+}
+
+void tight_loop_contents(void) {
+    busy_wait_us(1);
+}
+
+void __wfi(void) {
+    if (sim.core == 0)
+        core0_idle(SIM_NEVER, true, false);
+    else
+        core1_wait(SIM_NEVER, true);
+}
+
+void __wfe(void) {
+    if (sim.core == 0)
+        core0_idle(SIM_NEVER, true, true);
+    else
+        core1_wait(SIM_NEVER, true);
+}
+
+void __sev(void) {
+    sim.event_flag[0] = true;
+    sim.event_flag[1] = true;
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout) {
+    if (sim.core == 0)
+        core0_idle(timeout, true, true);
+    else
+        core1_wait(timeout, true);
+    return sim.now_us >= timeout;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    if (!sim.core1_stack)
+        sim.core1_stack = malloc(SIM_CORE1_STACK);
+    sim.core1_entry = entry;
+    getcontext(&sim.core1_ctx);
+    sim.core1_ctx.uc_stack.ss_sp = sim.core1_stack;
+    sim.core1_ctx.uc_stack.ss_size = SIM_CORE1_STACK;
+    sim.core1_ctx.uc_link = NULL;
+    makecontext(&sim.core1_ctx, core1_trampoline, 0);
+    sim.core1_started = true;
+    sim.core1_finished = false;
+    sim.core1_waiting = false;
+    sim.core1_deadline = SIM_NEVER;
+}
+
+void multicore_reset_core1(void) {
+    sim.core1_started = false;
+}
+
+// ---------------------------------------------------------------------------
+// FIFO entre os núcleos
+
+static fifo_t *rx_fifo(void) {
+    return &sim.fifo[sim.core];
+}
+
+static fifo_t *tx_fifo(void) {
+    return &sim.fifo[sim.core ^ 1];
+}
+
+bool multicore_fifo_rvalid(void) {
+    return rx_fifo()->count > 0;
+}
+
+bool multicore_fifo_wready(void) {
+    return tx_fifo()->count < SIM_FIFO_DEPTH;
+}
+
+void multicore_fifo_push_blocking(uint32_t data) {
+    while (!multicore_fifo_wready()) {
+        __sev();
+        if (sim.core == 0)
+            core0_idle(sim.now_us + 1, false, false);
+        else
+            core1_wait(sim.now_us + 1, false);
+    }
+    fifo_t *f = tx_fifo();
+    f->data[(f->head + f->count++) % SIM_FIFO_DEPTH] = data;
+    __sev();
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    while (!multicore_fifo_rvalid())
+        __wfe();
+    fifo_t *f = rx_fifo();
+    uint32_t data = f->data[f->head];
+    f->head = (f->head + 1) % SIM_FIFO_DEPTH;
+    f->count--;
+    return data;
+}
+
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *out) {
+    uint64_t deadline = sim.now_us + timeout_us;
+    while (!multicore_fifo_rvalid()) {
+        if (sim.now_us >= deadline)
+            return false;
+        best_effort_wfe_or_timeout(deadline);
+    }
+    *out = multicore_fifo_pop_blocking();
+    return true;
+}
+
+void multicore_fifo_drain(void) {
+    rx_fifo()->count = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Ciclo de vida
+
+void sim_init(void) {
+    memset(&sim, 0, sizeof(sim));
+    sim.irq_enabled[0] = sim.irq_enabled[1] = true;
+    sim.core1_deadline = SIM_NEVER;
+    ssd1306_hal_mock_reset();
+    ssd1306_hal_mock_set_clock(time_us_64, busy_wait_us);
+    sim_periph_init();
+}
+
+void sim_set_exit_handler(void (*handler)(int status)) {
+    sim.exit_handler = handler;
+}
+
+void sim_exit(int status) {
+    void (*handler)(int) = sim.exit_handler;
+    sim.exit_handler = NULL;
+    if (handler)
+        handler(status);
+    fflush(stdout);
+    exit(status);
+}
@@ -0,0 +1,296 @@
+#include <stdatomic.h>
+#include "input.h"
+#include "adc_stream.h"
+#include "temperature.h"
+#include "joystick.h"
+#include "keypad.h"
+#include "debounce.h"
+#include "trace.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+
+// Fila de produtor único / consumidor único. O produtor é o contexto de interrupção
+// (os dois timers de amostragem usam o mesmo alarme e não se interrompem); o
+// consumidor é o loop principal. Cada lado só escreve o próprio índice, então não há travas.
+static struct {
+    input_event_t events[INPUT_QUEUE_SIZE];
+    _Atomic uint32_t head; // Escrito pelo produtor
+    _Atomic uint32_t tail; // Escrito pelo consumidor
+    uint32_t dropped;      // Eventos descartados com a fila cheia
+} queue;
+
+// Entradas do debouncer: as teclas do teclado matricial nos bits 0..KEYPAD_KEYS-1
+// (posição na matriz) e os botões a partir de BUTTON_BIT, na ordem da tabela
+#define BUTTON_BIT KEYPAD_KEYS
+
+typedef struct {
+    uint gpio;
+    uint8_t press_event;
+    uint32_t long_press_us;   // 0 = sem INPUT_LONG_PRESS; senão press_event sai ao soltar antes do prazo
+} button_t;
+
+static const button_t buttons[] = {
+    {JOYSTICK_PB, INPUT_SELECT,  INPUT_LONG_PRESS_US},
+    {BOTAO_A,     INPUT_BACK,    INPUT_LONG_PRESS_US},
+    {BOTAO_B,     INPUT_BOOTSEL, 0},
+};
+
+#define BUTTONS_MASK (((1u << count_of(buttons)) - 1) << BUTTON_BIT)
+#define BUTTON_A_BIT (BUTTON_BIT + 1)   // Botão A, segundo da tabela: modificador do acorde
+
+static debounce_t debouncer;
+static bool chorded;            // O Botão A pressionado já fez parte de um acorde
+static uint scan_phase;
+static bool sleeping;       // Varredura parada, despertar por borda de GPIO
+
+// Estado de cada eixo do joystick: filtro/histerese e repetição acelerada
+typedef struct {
+    uint adc_input;
+    joystick_axis_t axis;
+    joystick_repeat_t repeat;
+} axis_t;
+
+static axis_t axes[] = {
+    {.adc_input = ADC_CHANNEL_JOYSTICK_Y}, // Eixo Y para Navegação
+    {.adc_input = ADC_CHANNEL_JOYSTICK_X}, // Eixo X para Navegação
+};
+
+static repeating_timer_t sample_timer;
+static repeating_timer_t scan_timer;
+static input_latency_t latency;
+
+static void push(const input_event_t *event) {
+    uint32_t head = atomic_load_explicit(&queue.head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&queue.tail, memory_order_acquire);
+    if (head - tail == INPUT_QUEUE_SIZE) {
+        queue.dropped++;
+        return;
+    }
+    queue.events[head & (INPUT_QUEUE_SIZE - 1)] = *event;
+    atomic_store_explicit(&queue.head, head + 1, memory_order_release);
+}
+
+static void push_event(uint8_t type, uint8_t gpio, uint32_t now) {
+    push(&(input_event_t){.type = type, .gpio = gpio, .timestamp_us = now});
+}
+
+static void push_key(uint8_t type, uint index, uint32_t now) {
+    push(&(input_event_t){.type = type, .key = (uint8_t)keypad_key(index), .timestamp_us = now});
+}
+
+bool input_poll(input_event_t *event) {
+    uint32_t tail = atomic_load_explicit(&queue.tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&queue.head, memory_order_acquire);
+    if (head == tail)
+        return false;
+    *event = queue.events[tail & (INPUT_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&queue.tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool input_pending(void) {
+    return atomic_load_explicit(&queue.head, memory_order_acquire) !=
+           atomic_load_explicit(&queue.tail, memory_order_relaxed);
+}
+
+uint32_t input_dropped(void) {
+    return queue.dropped;
+}
+
+// Evento do botão na entrada i. Com o Botão A pressionado, o botão do joystick
+// gera INPUT_CHORD (o pressionamento longo dele é ignorado) e o Botão A não
+// gera mais nada até ser solto, para o acorde não voltar ao menu principal.
+static void push_button(uint i, uint8_t type, uint32_t now) {
+    const button_t *b = &buttons[i - BUTTON_BIT];
+    if (i == BUTTON_A_BIT && chorded)
+        return;
+    if (b->gpio == JOYSTICK_PB && debounce_active(&debouncer, BUTTON_A_BIT)) {
+        chorded = true;
+        if (type != b->press_event)
+            return;
+        type = INPUT_CHORD;
+    }
+    push_event(type, (uint8_t)b->gpio, now);
+}
+
+// Bordas aceitas pelo debouncer -> eventos (só roda quando alguma entrada mudou)
+// Um botão com pressionamento longo só gera o seu evento ao ser solto antes do
+// prazo; depois do prazo gera apenas INPUT_LONG_PRESS, e nunca os dois.
+static void dispatch(const debounce_edges_t *edges, uint32_t now) {
+    if (edges->pressed & (1u << BUTTON_A_BIT))
+        chorded = false;
+    uint32_t buttons_short = edges->short_released & BUTTONS_MASK;
+    for (uint32_t m = edges->pressed | buttons_short; m; m &= m - 1) {
+        uint i = (uint)__builtin_ctz(m);
+        if (i < BUTTON_BIT) {
+            push_key(INPUT_KEY_PRESS, i, now);
+            continue;
+        }
+        if (!buttons[i - BUTTON_BIT].long_press_us || (buttons_short >> i) & 1u) {
+            TRACE_INSTANT(TRACE_INPUT_IRQ);
+            push_button(i, buttons[i - BUTTON_BIT].press_event, now);
+        }
+    }
+    for (uint32_t m = edges->released & ~BUTTONS_MASK; m; m &= m - 1)
+        push_key(INPUT_KEY_RELEASE, (uint)__builtin_ctz(m), now);
+    for (uint32_t m = edges->long_pressed; m; m &= m - 1) {
+        uint i = (uint)__builtin_ctz(m);
+        if (i >= BUTTON_BIT)
+            push_button(i, INPUT_LONG_PRESS, now);
+        else
+            push_key(INPUT_KEY_HOLD, i, now);
+    }
+}
+
+// Uma leitura de todos os pinos por tick: a linha selecionada do teclado e, uma
+// vez por leitura completa da matriz, os botões. Assim toda entrada é amostrada
+// a cada INPUT_SCAN_US * KEYPAD_ROWS e o debounce de todas custa o mesmo.
+void input_scan_step(void) {
+    uint32_t now = time_us_32();
+    uint32_t levels = gpio_get_all();
+    uint32_t active;
+    uint32_t sample = keypad_sample(levels, &active);
+    if (++scan_phase == KEYPAD_ROWS) {
+        scan_phase = 0;
+        for (uint i = 0; i < count_of(buttons); i++)
+            sample |= (~levels >> buttons[i].gpio & 1u) << (BUTTON_BIT + i); // Ativos em nível baixo
+        active |= BUTTONS_MASK;
+    }
+
+    debounce_edges_t edges;
+    debounce_update(&debouncer, sample, active, now, &edges);
+    if (edges.pressed | edges.released | edges.long_pressed)
+        dispatch(&edges, now);
+}
+
+static bool scan_timer_callback(repeating_timer_t *rt) {
+    (void)rt;
+    input_scan_step();
+    return true;
+}
+
+// GPIOs que acordam a varredura: botões e colunas do teclado (com todas as linhas em nível baixo)
+static uint32_t wake_mask(void) {
+    uint32_t mask = keypad_col_mask();
+    for (uint i = 0; i < count_of(buttons); i++)
+        mask |= 1u << buttons[i].gpio;
+    return mask;
+}
+
+static void wake_irq(uint gpio, uint32_t events);
+
+static void set_wake_irqs(bool enabled) {
+    for (uint32_t m = wake_mask(); m; m &= m - 1)
+        gpio_set_irq_enabled_with_callback((uint)__builtin_ctz(m), GPIO_IRQ_EDGE_FALL, enabled, wake_irq);
+}
+
+// Com interrupções mascaradas ou dentro da IRQ de GPIO
+static void resume_scan(void) {
+    sleeping = false;
+    set_wake_irqs(false);
+    keypad_select_all(false);
+    scan_phase = 0;
+    add_repeating_timer_us(-INPUT_SCAN_US, scan_timer_callback, NULL, &scan_timer);
+}
+
+// Primeira borda com a varredura parada: retoma a varredura e avisa o loop
+// principal com o instante da borda. O debounce confirma o pressionamento em seguida.
+static void wake_irq(uint gpio, uint32_t events) {
+    (void)events;
+    if (!sleeping)
+        return;
+    uint32_t now = time_us_32();
+    resume_scan();
+    push_event(INPUT_WAKE, (uint8_t)gpio, now);
+}
+
+void input_sleep(bool sleep) {
+    uint32_t irq = save_and_disable_interrupts();
+    if (sleep && !sleeping) {
+        cancel_repeating_timer(&scan_timer);
+        sleeping = true;
+        keypad_select_all(true);
+        set_wake_irqs(true);
+    } else if (!sleep && sleeping) {
+        resume_scan();
+    }
+    restore_interrupts(irq);
+}
+
+bool input_any_down(void) {
+    return debouncer.state != 0;
+}
+
+bool input_button_down(uint gpio) {
+    for (uint i = 0; i < count_of(buttons); i++)
+        if (buttons[i].gpio == gpio)
+            return debounce_active(&debouncer, BUTTON_BIT + i);
+    return false;
+}
+
+static bool sample_timer_callback(repeating_timer_t *rt) {
+    (void)rt;
+    uint32_t now = time_us_32();
+    bool moved = false;
+
+    for (uint i = 0; i < count_of(axes); i++) {
+        axis_t *a = &axes[i];
+        // A média do anel da DMA já suaviza o ruído; o filtro em ponto fixo completa
+        int16_t deviation = joystick_filter(&a->axis, adc_stream_average(a->adc_input));
+        int8_t direction = joystick_direction(&a->axis, deviation);
+        if (joystick_repeat_step(&a->repeat, direction, now)) {
+            push_event(direction < 0 ? INPUT_DOWN : INPUT_UP, 0, now); // Leitura baixa = para baixo
+            moved = true;
+        }
+    }
+    // Só as amostras que geraram evento entram no trace (as demais encheriam o anel)
+    if (moved)
+        TRACE_COMPLETE(TRACE_JOYSTICK, now, time_us_32());
+    return true;
+}
+
+void input_init(void) {
+    // Conversão contínua dos eixos e dos sensores de temperatura (temperature.c)
+    // pela DMA; a CPU só lê as médias
+    adc_stream_init(INPUT_ADC_CHANNELS | TEMPERATURE_ADC_CHANNELS);
+
+    // Calibração: o joystick deve estar em repouso na partida. Espera o anel
+    // encher e usa a média de cada eixo como centro.
+    sleep_ms(2 * ADC_STREAM_SAMPLES_PER_CHANNEL * 1000 / ADC_STREAM_RATE_HZ);
+    for (uint i = 0; i < count_of(axes); i++) {
+        uint32_t count, stride;
+        const uint16_t *samples = adc_stream_samples(axes[i].adc_input, &count, &stride);
+        joystick_axis_init(&axes[i].axis, joystick_average(samples, count, stride));
+    }
+
+    // Botões e teclado sem interrupção de GPIO: um repique não gera evento, só
+    // uma leitura estável por DEBOUNCE_SAMPLES amostras seguidas
+    debounce_init(&debouncer);
+    for (uint i = 0; i < count_of(buttons); i++) {
+        gpio_init(buttons[i].gpio);
+        gpio_set_dir(buttons[i].gpio, GPIO_IN);
+        gpio_pull_up(buttons[i].gpio);
+        debounce_set_long_press(&debouncer, BUTTON_BIT + i, buttons[i].long_press_us);
+    }
+    keypad_init();
+    for (uint i = 0; i < KEYPAD_KEYS; i++)
+        debounce_set_long_press(&debouncer, i, KEYPAD_HOLD_US);
+
+    // Período negativo: intervalo entre inícios de callback, independente da duração
+    add_repeating_timer_ms(-INPUT_SAMPLE_MS, sample_timer_callback, NULL, &sample_timer);
+    add_repeating_timer_us(-INPUT_SCAN_US, scan_timer_callback, NULL, &scan_timer);
+}
+
+// Registra o tempo entre o evento e o instante (time_us_32) em que a tela passou a refleti-lo
+void input_latency_record(uint32_t event_us, uint32_t shown_us) {
+    uint32_t elapsed = shown_us - event_us;
+    latency.last_us = elapsed;
+    if (elapsed > latency.max_us)
+        latency.max_us = elapsed;
+    latency.avg_us = latency.samples ? latency.avg_us + ((int32_t)(elapsed - latency.avg_us) >> 3) : elapsed;
+    latency.samples++;
+}
+
+const input_latency_t *input_latency(void) {
+    return &latency;
+}
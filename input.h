@@ -0,0 +1,75 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// Entrada orientada a eventos: dois timers repetitivos produzem eventos tipados
+// numa fila circular sem travas e o loop principal consome com input_poll. Um
+// amostra o joystick (lido do anel de DMA do ADC); o outro lê todos os pinos de
+// uma vez com gpio_get_all e faz o debounce dos botões e do teclado matricial
+// (keypad.h) em paralelo, com contadores verticais (debounce.h).
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+// Configuração dos Botões e Joystick
+#define JOYSTICK_X_PIN 26  // GPIO para eixo X
+#define JOYSTICK_Y_PIN 27  // GPIO para eixo Y
+#define JOYSTICK_PB 22     // GPIO para botão do Joystick (Selecionar)
+#define BOTAO_A 5          // GPIO para voltar ao Menu Principal
+#define BOTAO_B 6          // GPIO para BOOTSEL
+
+#define INPUT_SAMPLE_MS 20         // Período de amostragem do joystick
+#define INPUT_SCAN_US 1000         // Tick dos botões e do teclado: cada entrada é lida a cada 4 ticks
+#define INPUT_LONG_PRESS_US 800000 // Botão mantido por esse tempo gera INPUT_LONG_PRESS
+
+#define INPUT_QUEUE_SIZE 32        // Potência de 2
+
+// Canais convertidos em round-robin pelo ADC (eixos Y e X do joystick)
+#define INPUT_ADC_CHANNELS ((1u << 0) | (1u << 1))
+
+typedef enum {
+    INPUT_UP,
+    INPUT_DOWN,
+    INPUT_SELECT,
+    INPUT_BACK,
+    INPUT_LONG_PRESS,
+    INPUT_CHORD,           // Botão do joystick solto com o Botão A pressionado
+    INPUT_KEY_PRESS,       // Teclado matricial (keypad.h)
+    INPUT_KEY_RELEASE,
+    INPUT_KEY_HOLD,
+    INPUT_BOOTSEL,         // Botão B
+    INPUT_WAKE             // Borda que retomou a varredura parada por input_sleep
+} input_event_type_t;
+
+typedef struct {
+    uint8_t type;          // input_event_type_t
+    uint8_t gpio;          // Botão de origem (INPUT_SELECT, INPUT_BACK, INPUT_LONG_PRESS, INPUT_CHORD, INPUT_BOOTSEL, INPUT_WAKE)
+    uint8_t key;           // Tecla de KEYPAD_LAYOUT (INPUT_KEY_*)
+    uint32_t timestamp_us; // time_us_32() no momento da detecção
+} input_event_t;
+
+// Estatísticas de latência entrada -> quadro transmitido ao OLED
+typedef struct {
+    uint32_t last_us;
+    uint32_t max_us;
+    uint32_t avg_us;   // Média móvel exponencial (peso 1/8)
+    uint32_t samples;
+} input_latency_t;
+
+void input_init(void);
+void input_scan_step(void);           // Um tick do debounce (chamado pelo timer; exposto para o benchmark)
+bool input_button_down(uint gpio);    // Estado do botão após o debounce
+bool input_any_down(void);            // Algum botão ou tecla pressionado após o debounce
+
+// Para o tick dos botões e do teclado (o joystick segue amostrado) e arma
+// interrupções de borda nos botões e colunas: a primeira borda retoma a
+// varredura e gera INPUT_WAKE. input_sleep(false) retoma de imediato.
+void input_sleep(bool sleep);
+
+bool input_poll(input_event_t *event);
+bool input_pending(void);
+uint32_t input_dropped(void);
+
+void input_latency_record(uint32_t event_us, uint32_t shown_us);
+const input_latency_t *input_latency(void);
+
+#endif // INPUT_H
@@ -0,0 +1,63 @@
+#include "joystick.h"
+
+// Define o centro do eixo e posiciona o filtro nele (evita um transitório na partida)
+void joystick_axis_init(joystick_axis_t *axis, uint16_t center) {
+    axis->center = center;
+    axis->filtered = (int32_t)center << JOYSTICK_FILTER_FRAC;
+    axis->direction = 0;
+}
+
+// Média de count amostras espaçadas de stride (útil para calibrar a partir de um buffer intercalado)
+uint16_t joystick_average(const uint16_t *samples, uint32_t count, uint32_t stride) {
+    if (count == 0)
+        return 0;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++)
+        sum += samples[i * stride];
+    return (uint16_t)((sum + count / 2) / count);
+}
+
+// Média móvel exponencial em ponto fixo; retorna o desvio filtrado em relação ao centro
+int16_t joystick_filter(joystick_axis_t *axis, uint16_t sample) {
+    int32_t target = (int32_t)sample << JOYSTICK_FILTER_FRAC;
+    axis->filtered += (target - axis->filtered) >> JOYSTICK_FILTER_SHIFT;
+    return (int16_t)((axis->filtered >> JOYSTICK_FILTER_FRAC) - axis->center);
+}
+
+// Zona morta com histerese: entra numa direção acima de JOYSTICK_ENTER e só sai
+// abaixo de JOYSTICK_EXIT, para que ruído perto do limiar não gere passos extras
+int8_t joystick_direction(joystick_axis_t *axis, int16_t deviation) {
+    int16_t magnitude = deviation < 0 ? -deviation : deviation;
+    int8_t sign = deviation < 0 ? -1 : 1;
+
+    if (axis->direction == 0) {
+        if (magnitude > JOYSTICK_ENTER)
+            axis->direction = sign;
+    } else if (magnitude < JOYSTICK_EXIT || sign != axis->direction) {
+        axis->direction = (magnitude > JOYSTICK_ENTER) ? sign : 0;
+    }
+    return axis->direction;
+}
+
+// Decide se um passo de navegação deve ser emitido agora: um ao inclinar, outro após
+// JOYSTICK_REPEAT_DELAY_US e depois repetições cada vez mais rápidas até o mínimo
+bool joystick_repeat_step(joystick_repeat_t *repeat, int8_t direction, uint32_t now_us) {
+    if (direction == 0) {
+        repeat->direction = 0;
+        return false;
+    }
+    if (direction != repeat->direction) {
+        repeat->direction = direction;
+        repeat->next_us = now_us + JOYSTICK_REPEAT_DELAY_US;
+        repeat->interval_us = JOYSTICK_REPEAT_START_US;
+        return true;
+    }
+    if ((int32_t)(now_us - repeat->next_us) < 0)
+        return false;
+
+    repeat->next_us = now_us + repeat->interval_us;
+    repeat->interval_us -= repeat->interval_us / 4;
+    if (repeat->interval_us < JOYSTICK_REPEAT_MIN_US)
+        repeat->interval_us = JOYSTICK_REPEAT_MIN_US;
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+// Processamento do joystick em funções puras (sem acesso a hardware), para que
+// filtro, calibração, zona morta e repetição possam ser exercitados no host.
+// Toda a aritmética é inteira: o M0+ não tem FPU.
+#include <stdbool.h>
+#include <stdint.h>
+
+#define JOYSTICK_FILTER_FRAC 4   // Bits fracionários do valor filtrado (Q4)
+#define JOYSTICK_FILTER_SHIFT 2  // Peso da nova amostra na média móvel: 1/4
+
+// Zona morta com histerese, em contagens do ADC a partir do centro calibrado
+#define JOYSTICK_ENTER 1000      // Desvio para considerar o eixo inclinado
+#define JOYSTICK_EXIT 600        // Desvio abaixo do qual o eixo volta ao centro
+
+// Repetição acelerada enquanto o eixo fica inclinado
+#define JOYSTICK_REPEAT_DELAY_US 400000 // Do primeiro passo à primeira repetição
+#define JOYSTICK_REPEAT_START_US 200000 // Intervalo inicial entre repetições
+#define JOYSTICK_REPEAT_MIN_US 60000    // Intervalo mínimo após a aceleração
+
+typedef struct {
+    int32_t filtered;   // Valor filtrado em Q(JOYSTICK_FILTER_FRAC)
+    int16_t center;     // Leitura em repouso (calibração)
+    int8_t direction;   // Estado da histerese: -1, 0 ou +1
+} joystick_axis_t;
+
+typedef struct {
+    int8_t direction;
+    uint32_t next_us;
+    uint32_t interval_us;
+} joystick_repeat_t;
+
+void joystick_axis_init(joystick_axis_t *axis, uint16_t center);
+uint16_t joystick_average(const uint16_t *samples, uint32_t count, uint32_t stride);
+
+int16_t joystick_filter(joystick_axis_t *axis, uint16_t sample);
+int8_t joystick_direction(joystick_axis_t *axis, int16_t deviation);
+bool joystick_repeat_step(joystick_repeat_t *repeat, int8_t direction, uint32_t now_us);
+
+#endif // JOYSTICK_H
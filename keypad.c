@@ -0,0 +1,81 @@
+#include "keypad.h"
+#include "hardware/gpio.h"
+
+// Linhas sem seleção ficam como entrada (alta impedância), e não em nível alto:
+// com duas teclas da mesma coluna apertadas, uma linha em nível alto e outra em
+// nível baixo ficariam em curto pela coluna.
+
+static const uint row_pins[KEYPAD_ROWS] = KEYPAD_ROW_PINS;
+static const uint col_pins[KEYPAD_COLS] = KEYPAD_COL_PINS;
+static const char layout[] = KEYPAD_LAYOUT;
+
+static uint8_t raw[KEYPAD_ROWS];   // Última leitura de cada linha: bit = coluna fechada
+static uint32_t row_mask;
+static uint row;                   // Linha selecionada, lida no próximo tick
+static keypad_stats_t stats;
+
+uint32_t keypad_sample(uint32_t levels, uint32_t *active) {
+    uint32_t low = ~levels;
+    uint8_t cols = 0;
+    for (uint c = 0; c < KEYPAD_COLS; c++)
+        cols |= ((low >> col_pins[c]) & 1u) << c;
+
+    // Seleciona já a próxima linha: as colunas têm o tick inteiro para estabilizar
+    uint current = row;
+    row = (row + 1) % KEYPAD_ROWS;
+    gpio_set_dir_masked(row_mask, 1u << row_pins[row]);
+    raw[current] = cols;
+    if (row == 0)
+        stats.scans++;
+
+    // Sem diodos, três teclas nos cantos de um retângulo fecham o quarto canto.
+    // Duas linhas com duas ou mais colunas em comum não distinguem tecla real de
+    // fantasma: essas teclas não são amostradas até a ambiguidade acabar.
+    uint8_t ghost = 0;
+    for (uint r = 0; r < KEYPAD_ROWS; r++) {
+        uint8_t common = r == current ? 0 : cols & raw[r];
+        if (common & (common - 1))
+            ghost |= common;
+    }
+    if (ghost)
+        stats.ghost_blocked++;
+
+    uint shift = current * KEYPAD_COLS;
+    *active = (uint32_t)(((1u << KEYPAD_COLS) - 1) & ~ghost) << shift;
+    return (uint32_t)cols << shift;
+}
+
+void keypad_init(void) {
+    for (uint r = 0; r < KEYPAD_ROWS; r++) {
+        gpio_init(row_pins[r]);
+        gpio_put(row_pins[r], 0);   // Nível de saída fixo; a seleção só muda a direção
+        gpio_pull_up(row_pins[r]);
+        row_mask |= 1u << row_pins[r];
+    }
+    for (uint c = 0; c < KEYPAD_COLS; c++) {
+        gpio_init(col_pins[c]);
+        gpio_set_dir(col_pins[c], GPIO_IN);
+        gpio_pull_up(col_pins[c]);
+    }
+    keypad_select_all(false);
+}
+
+void keypad_select_all(bool all) {
+    row = 0;
+    gpio_set_dir_masked(row_mask, all ? row_mask : 1u << row_pins[row]);
+}
+
+uint32_t keypad_col_mask(void) {
+    uint32_t mask = 0;
+    for (uint c = 0; c < KEYPAD_COLS; c++)
+        mask |= 1u << col_pins[c];
+    return mask;
+}
+
+char keypad_key(uint index) {
+    return index < KEYPAD_KEYS ? layout[index] : 0;
+}
+
+const keypad_stats_t *keypad_stats(void) {
+    return &stats;
+}
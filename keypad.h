@@ -0,0 +1,41 @@
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+// Teclado matricial 4x4 lido sem esperas pelo tick de varredura de input.c: a
+// cada tick, keypad_sample extrai as colunas da linha selecionada da mesma
+// leitura de gpio_get_all usada para os botões e seleciona a linha seguinte, de
+// modo que a matriz inteira é lida a cada KEYPAD_ROWS ticks. O debounce (um
+// contador vertical para todas as entradas, debounce.h) e os eventos
+// INPUT_KEY_PRESS, INPUT_KEY_RELEASE e INPUT_KEY_HOLD ficam em input.c; cada
+// tecla é independente, então várias podem estar apertadas ao mesmo tempo.
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "input.h"
+
+#define KEYPAD_ROWS 4
+#define KEYPAD_COLS 4
+#define KEYPAD_KEYS (KEYPAD_ROWS * KEYPAD_COLS)
+#define KEYPAD_ROW_PINS {18, 19, 20, 4}    // Só a linha selecionada é saída (nível baixo)
+#define KEYPAD_COL_PINS {16, 17, 9, 8}     // Entradas com pull-up
+#define KEYPAD_LAYOUT "123A456B789C*0#D"   // Tecla de cada posição, linha a linha
+
+#define KEYPAD_HOLD_US INPUT_LONG_PRESS_US // Tecla mantida por esse tempo gera INPUT_KEY_HOLD
+
+typedef struct {
+    uint32_t scans;           // Leituras completas da matriz
+    uint32_t ghost_blocked;   // Leituras de tecla ignoradas por ambiguidade (fantasma)
+} keypad_stats_t;
+
+void keypad_init(void);
+// Teclas fechadas da linha lida (bit linha * KEYPAD_COLS + coluna) a partir dos
+// níveis de gpio_get_all; active recebe as teclas que podem ser amostradas
+uint32_t keypad_sample(uint32_t levels, uint32_t *active);
+// Todas as linhas em nível baixo (qualquer tecla puxa a sua coluna: despertar
+// por borda de GPIO) ou de volta à varredura a partir da primeira linha
+void keypad_select_all(bool all);
+uint32_t keypad_col_mask(void);       // GPIOs das colunas
+char keypad_key(uint index);          // Caractere da posição, 0 fora da matriz
+const keypad_stats_t *keypad_stats(void);
+
+#endif // KEYPAD_H
@@ -0,0 +1,118 @@
+#include "led_font.h"
+
+#define FIRST_CHAR 0x20
+#define LAST_CHAR 0x5F
+#define DEGREE_GLYPH (LAST_CHAR - FIRST_CHAR + 1)   // Depois de '_'
+#define FALLBACK '?'
+
+// Um glifo a cada LED_FONT_MAX_COLS bytes; a largura é a última coluna acesa
+static const uint8_t glyphs[][LED_FONT_MAX_COLS] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // espaço
+    {0x17, 0x00, 0x00, 0x00, 0x00}, // !
+    {0x03, 0x00, 0x03, 0x00, 0x00}, // "
+    {0x1f, 0x0a, 0x1f, 0x00, 0x00}, // #
+    {0x12, 0x1f, 0x09, 0x00, 0x00}, // $
+    {0x19, 0x04, 0x02, 0x11, 0x00}, // %
+    {0x0a, 0x15, 0x1a, 0x00, 0x00}, // &
+    {0x03, 0x00, 0x00, 0x00, 0x00}, // '
+    {0x0e, 0x11, 0x00, 0x00, 0x00}, // (
+    {0x11, 0x0e, 0x00, 0x00, 0x00}, // )
+    {0x05, 0x02, 0x05, 0x00, 0x00}, // *
+    {0x04, 0x0e, 0x04, 0x00, 0x00}, // +
+    {0x10, 0x08, 0x00, 0x00, 0x00}, // ,
+    {0x04, 0x04, 0x04, 0x00, 0x00}, // -
+    {0x10, 0x00, 0x00, 0x00, 0x00}, // .
+    {0x18, 0x04, 0x03, 0x00, 0x00}, // /
+    {0x1f, 0x11, 0x1f, 0x00, 0x00}, // 0
+    {0x12, 0x1f, 0x10, 0x00, 0x00}, // 1
+    {0x1d, 0x15, 0x17, 0x00, 0x00}, // 2
+    {0x11, 0x15, 0x1f, 0x00, 0x00}, // 3
+    {0x07, 0x04, 0x1f, 0x00, 0x00}, // 4
+    {0x17, 0x15, 0x1d, 0x00, 0x00}, // 5
+    {0x1f, 0x15, 0x1d, 0x00, 0x00}, // 6
+    {0x01, 0x1d, 0x03, 0x00, 0x00}, // 7
+    {0x1f, 0x15, 0x1f, 0x00, 0x00}, // 8
+    {0x17, 0x15, 0x1f, 0x00, 0x00}, // 9
+    {0x0a, 0x00, 0x00, 0x00, 0x00}, // :
+    {0x10, 0x0a, 0x00, 0x00, 0x00}, // ;
+    {0x04, 0x0a, 0x11, 0x00, 0x00}, // <
+    {0x0a, 0x0a, 0x0a, 0x00, 0x00}, // =
+    {0x11, 0x0a, 0x04, 0x00, 0x00}, // >
+    {0x01, 0x15, 0x07, 0x00, 0x00}, // ?
+    {0x0e, 0x11, 0x15, 0x16, 0x00}, // @
+    {0x1e, 0x05, 0x1e, 0x00, 0x00}, // A
+    {0x1f, 0x15, 0x0a, 0x00, 0x00}, // B
+    {0x0e, 0x11, 0x11, 0x00, 0x00}, // C
+    {0x1f, 0x11, 0x0e, 0x00, 0x00}, // D
+    {0x1f, 0x15, 0x11, 0x00, 0x00}, // E
+    {0x1f, 0x05, 0x01, 0x00, 0x00}, // F
+    {0x0e, 0x11, 0x15, 0x1d, 0x00}, // G
+    {0x1f, 0x04, 0x1f, 0x00, 0x00}, // H
+    {0x11, 0x1f, 0x11, 0x00, 0x00}, // I
+    {0x08, 0x10, 0x0f, 0x00, 0x00}, // J
+    {0x1f, 0x04, 0x1b, 0x00, 0x00}, // K
+    {0x1f, 0x10, 0x10, 0x00, 0x00}, // L
+    {0x1f, 0x02, 0x04, 0x02, 0x1f}, // M
+    {0x1f, 0x02, 0x04, 0x1f, 0x00}, // N
+    {0x0e, 0x11, 0x0e, 0x00, 0x00}, // O
+    {0x1f, 0x05, 0x02, 0x00, 0x00}, // P
+    {0x0e, 0x11, 0x09, 0x16, 0x00}, // Q
+    {0x1f, 0x05, 0x1a, 0x00, 0x00}, // R
+    {0x12, 0x15, 0x09, 0x00, 0x00}, // S
+    {0x01, 0x1f, 0x01, 0x00, 0x00}, // T
+    {0x1f, 0x10, 0x1f, 0x00, 0x00}, // U
+    {0x0f, 0x10, 0x0f, 0x00, 0x00}, // V
+    {0x1f, 0x08, 0x04, 0x08, 0x1f}, // W
+    {0x1b, 0x04, 0x1b, 0x00, 0x00}, // X
+    {0x03, 0x1c, 0x03, 0x00, 0x00}, // Y
+    {0x19, 0x15, 0x13, 0x00, 0x00}, // Z
+    {0x1f, 0x11, 0x00, 0x00, 0x00}, // [
+    {0x03, 0x04, 0x18, 0x00, 0x00}, // barra invertida
+    {0x11, 0x1f, 0x00, 0x00, 0x00}, // ]
+    {0x02, 0x01, 0x02, 0x00, 0x00}, // ^
+    {0x10, 0x10, 0x10, 0x00, 0x00}, // _
+    {0x07, 0x05, 0x07, 0x00, 0x00}, // °
+};
+
+// U+00C0..U+00FF sem acento (× vira X, ÷ vira /)
+static const char latin1_fold[] = "AAAAAAACEEEEIIIIDNOOOOOXOUUUUYPSAAAAAAACEEEEIIIIDNOOOOO/OUUUUYPY";
+
+static uint glyph_index(uint32_t c) {
+    if (c >= 'a' && c <= 'z')
+        c -= 'a' - 'A';
+    else if (c >= 0xC0 && c <= 0xFF)
+        c = (uint8_t)latin1_fold[c - 0xC0];
+    else if (c == 0xB0)
+        return DEGREE_GLYPH;
+    if (c < FIRST_CHAR || c > LAST_CHAR)
+        c = FALLBACK;
+    return c - FIRST_CHAR;
+}
+
+const uint8_t *led_font_glyph(uint32_t c, uint *width) {
+    const uint8_t *cols = glyphs[glyph_index(c)];
+    uint w = LED_FONT_MAX_COLS;
+    while (w > 0 && cols[w - 1] == 0)
+        w--;
+    *width = w ? w : LED_FONT_SPACE_COLS;
+    return cols;
+}
+
+// Só sequências de 1 e 2 bytes têm glifo; as maiores são puladas inteiras
+const uint8_t *led_font_next(const char **text, uint *width) {
+    const uint8_t *s = (const uint8_t *)*text;
+    uint32_t c = s[0];
+    uint len = 1;
+    if (c >= 0x80) {
+        len = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        for (uint i = 1; i < len; i++) {
+            if ((s[i] & 0xC0) != 0x80) {
+                len = 1;
+                break;
+            }
+        }
+        c = len == 2 ? ((c & 0x1F) << 6) | (s[1] & 0x3F) : FALLBACK;
+    }
+    *text += len;
+    return led_font_glyph(c, width);
+}
@@ -0,0 +1,22 @@
+#ifndef LED_FONT_H
+#define LED_FONT_H
+
+// Fonte da matriz de LEDs: glifos de 5 linhas e largura variável (até 5
+// colunas), um byte por coluna com o bit 0 na linha de cima. Cobre o ASCII de
+// ' ' a '_' e o símbolo de grau; minúsculas e letras acentuadas do Latin-1
+// usam a maiúscula sem acento, e o restante vira '?'.
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+#define LED_FONT_ROWS 5
+#define LED_FONT_MAX_COLS 5
+#define LED_FONT_SPACE_COLS 2   // Largura do espaço (glifo sem colunas acesas)
+
+// Colunas do glifo do caractere c (código Unicode); *width recebe a largura
+const uint8_t *led_font_glyph(uint32_t c, uint *width);
+
+// Decodifica um caractere UTF-8 de *text, avança o ponteiro e retorna o glifo.
+// Sequências inválidas consomem um byte e viram '?'.
+const uint8_t *led_font_next(const char **text, uint *width);
+
+#endif // LED_FONT_H
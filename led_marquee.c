@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <string.h>
+#include "led_marquee.h"
+#include "led_font.h"
+#include "output.h"
+#include "sched.h"
+#include "log.h"
+
+#if LED_FONT_ROWS != ROWS
+#error "A fonte da matriz deve ter a altura da matriz"
+#endif
+
+#define ROW_MASK ((1u << COLS) - 1)
+
+static char text[LED_MARQUEE_MAX_TEXT + 1];
+static const char *next;        // Próximo caractere a entrar
+static const uint8_t *glyph;    // Glifo entrando
+static uint glyph_width, glyph_col;
+static uint blank_cols;         // Colunas apagadas antes do próximo glifo
+static uint8_t rows[ROWS];      // Bit COLS - 1 = coluna da esquerda
+static led_word_t color;
+static bool loop;
+static uint32_t period_us = 1000000 / LED_MARQUEE_DEFAULT_CPS;
+static int task = SCHED_INVALID;
+
+static void rewind_text(void) {
+    next = text;
+    glyph_width = glyph_col = blank_cols = 0;
+}
+
+static bool matrix_empty(void) {
+    uint8_t any = 0;
+    for (uint row = 0; row < ROWS; row++)
+        any |= rows[row];
+    return any == 0;
+}
+
+// Próxima coluna a entrar pela direita; false quando o texto acabou e já saiu
+// da matriz
+static bool next_column(uint8_t *col) {
+    if (glyph_col == glyph_width && blank_cols == 0 && *next) {
+        glyph = led_font_next(&next, &glyph_width);
+        glyph_col = 0;
+    }
+    if (glyph_col < glyph_width) {
+        *col = glyph[glyph_col++];
+        if (glyph_col == glyph_width)
+            blank_cols = LED_MARQUEE_GAP_COLS;
+        return true;
+    }
+    if (blank_cols)
+        blank_cols--;
+    *col = 0;
+    return !matrix_empty() || *next;
+}
+
+static void marquee_step(void *arg) {
+    (void)arg;
+    uint8_t col;
+    if (!next_column(&col)) {
+        if (!loop) {
+            sched_cancel(task);
+            task = SCHED_INVALID;
+            return;
+        }
+        rewind_text();
+        next_column(&col);
+    }
+    for (uint row = 0; row < ROWS; row++) {
+        uint8_t old = rows[row];
+        uint8_t now = (uint8_t)(((old << 1) | ((col >> row) & 1u)) & ROW_MASK);
+        uint8_t changed = old ^ now;
+        rows[row] = now;
+        while (changed) {
+            uint bit = (uint)__builtin_ctz(changed);
+            changed &= (uint8_t)(changed - 1);
+            led_matrix_set_word(led_matrix_index(row, COLS - 1 - bit), (now >> bit) & 1u ? color : 0);
+        }
+    }
+    output_leds_update();
+}
+
+static void schedule(void) {
+    sched_cancel(task);
+    task = sched_after(period_us, period_us, marquee_step, NULL);
+    if (task == SCHED_INVALID)
+        LOG_W(LOG_OUTPUT, "letreiro: agendador cheio");
+}
+
+void led_marquee_start(const char *str, led_word_t c, bool repeat) {
+    // Corta numa fronteira de caractere UTF-8
+    size_t len = strlen(str);
+    if (len > LED_MARQUEE_MAX_TEXT) {
+        len = LED_MARQUEE_MAX_TEXT;
+        while (len > 0 && ((uint8_t)str[len] & 0xC0) == 0x80)
+            len--;
+    }
+    memcpy(text, str, len);
+    text[len] = '\0';
+    color = c;
+    loop = repeat;
+    rewind_text();
+    memset(rows, 0, sizeof(rows));
+    led_matrix_clear();
+    output_leds_update();
+    if (len)
+        schedule();
+    else
+        sched_cancel(task);
+}
+
+void led_marquee_number(int32_t number, led_word_t c, bool repeat) {
+    char buf[12];
+    snprintf(buf, sizeof(buf), "%ld", (long)number);
+    led_marquee_start(buf, c, repeat);
+}
+
+void led_marquee_set_speed(uint cols_per_s) {
+    period_us = 1000000 / (cols_per_s ? cols_per_s : 1);
+    if (sched_pending(task))
+        schedule();
+}
+
+void led_marquee_stop(void) {
+    sched_cancel(task);
+    task = SCHED_INVALID;
+    memset(rows, 0, sizeof(rows));
+    led_matrix_clear();
+    output_leds_update();
+}
+
+bool led_marquee_running(void) {
+    return sched_pending(task);
+}
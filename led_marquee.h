@@ -0,0 +1,31 @@
+#ifndef LED_MARQUEE_H
+#define LED_MARQUEE_H
+
+// Letreiro na matriz de LEDs: rola um texto (fonte de led_font.h) da direita
+// para a esquerda, uma coluna por passo. Cada linha da matriz é uma máscara de
+// COLS bits; a cada passo as máscaras são deslocadas, a coluna nova entra pela
+// direita e só os LEDs que mudaram são reescritos antes de publicar o quadro
+// ao núcleo 1 (output_leds_update). Os passos são uma tarefa periódica do
+// sched.h, no loop principal do núcleo 0.
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "led_matrix.h"
+
+#define LED_MARQUEE_MAX_TEXT 64     // Bytes de texto (UTF-8) guardados
+#define LED_MARQUEE_GAP_COLS 1      // Colunas apagadas entre dois glifos
+#define LED_MARQUEE_DEFAULT_CPS 8   // Colunas por segundo
+
+// Copia o texto e começa a rolá-lo com a matriz apagada; com loop, recomeça
+// depois que o texto sai por completo, senão a tarefa termina sozinha
+void led_marquee_start(const char *text, led_word_t color, bool loop);
+void led_marquee_number(int32_t number, led_word_t color, bool loop);
+
+// Vale também para o letreiro em andamento
+void led_marquee_set_speed(uint cols_per_s);
+
+// Para e apaga a matriz
+void led_marquee_stop(void);
+bool led_marquee_running(void);
+
+#endif // LED_MARQUEE_H
@@ -1,33 +1,129 @@
+#include <stdatomic.h>
+#include <string.h>
 #include "led_matrix.h" // Inclui o arquivo de cabeçalho local com as definições de funções e tipos de dados
+#include "led_lut.h"    // Gama e brilho global (gerado por tools/gen_led_lut.py)
+#include "led_font.h"
+
+// As cores são guardadas já como palavras do FIFO (gama e brilho aplicados em
+// led_matrix_set_pixel), de modo que enviar um quadro é só copiá-lo e estimar
+// a corrente, sem reconverter cada pixel.
+//
+// Envio em buffer duplo pela DMA, sem mascarar interrupções: o quadro é
+// copiado para o buffer livre e a DMA alimenta o FIFO de TX da
+// máquina de estados no ritmo do DREQ. Um alarme no fim do quadro (duração
+// calculada + LED_RESET_US) garante a pausa que trava as cores na fita, chama o
+// callback de quadro enviado e inicia o quadro que ficou pendente.
+//
+// O estado é trocado sem travas entre quem envia (núcleo 1, ver output.c) e o
+// alarme (alarm pool padrão, interrupção do núcleo 0):
+//   LEDS_IDLE      nada em envio; o buffer de trás é de quem envia
+//   LEDS_BUSY      o buffer da frente está em envio; o de trás é de quem envia
+//   LEDS_PENDING   o de trás está pronto e espera o alarme
+//   LEDS_STARTING  o alarme está trocando os buffers (poucas instruções)
+enum { LEDS_IDLE, LEDS_BUSY, LEDS_PENDING, LEDS_STARTING };
 
 // Variáveis globais para controle da matriz de LEDs WS2812
 static PIO np_pio;  // Instância da interface PIO
-static uint sm;     // Máquina de estado usada na PIO
-static npLED_t leds[LED_COUNT]; // Buffer de LEDs armazenando os valores de cor
+static uint sm;     // Máquina de estados usada na PIO
+static led_word_t leds[LED_COUNT]; // Buffer de LEDs com as palavras prontas para o FIFO
+static bool initialized;        // A PIO só é configurada uma vez
+
+static uint dma_ch;
+static dma_channel_config dma_config;
+static uint32_t frames[2][LED_CHAIN_MAX];   // Palavras prontas para o FIFO
+static uint frame_len[2];
+static uint32_t frame_started_us[2];
+static _Atomic uint front;                  // Buffer lido pela DMA
+static _Atomic uint state = LEDS_IDLE;
+static led_matrix_done_cb_t done_cb;
+static void *done_ctx;
+static led_matrix_power_t power = {0, 256, 0};
 
-// Mapeia um índice para a posição correta na matriz de LEDs (linha x coluna)
-static int map_index(int row, int col) {
-    return row * COLS + col;
+// Mapeia uma posição da matriz de LEDs (linha x coluna, linha 0 em cima) para o
+// índice na fita. Na BitDogLab a fita é em serpentina a partir do canto de
+// baixo: a primeira linha da fita é a de baixo, e as linhas pares da fita
+// correm da direita para a esquerda.
+uint led_matrix_index(uint row, uint col) {
+    uint r = ROWS - 1 - row;
+    return (r % 2 == 0) ? r * COLS + (COLS - 1 - col) : r * COLS + col;
 }
 
-// Converte valores RGB para o formato GRB exigido pelo WS2812
-static uint32_t rgb_to_grb(uint8_t r, uint8_t g, uint8_t b) {
-    return ((uint32_t)g << 16) | ((uint32_t)r << 8) | (uint32_t)b;
+// Converte valores RGB para a palavra do FIFO: a PIO desloca 24 bits a partir do
+// bit 31, na ordem G, R, B exigida pelo WS2812
+led_word_t led_matrix_color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)led_lut[g] << 24) | ((uint32_t)led_lut[r] << 16) | ((uint32_t)led_lut[b] << 8);
 }
 
 // Define a cor de um pixel específico na matriz de LEDs
 void led_matrix_set_pixel(uint index, uint8_t r, uint8_t g, uint8_t b) {
     if (index < LED_COUNT) {
-        leds[index] = (npLED_t){g, r, b};  // Define as cores no formato GRB
+        leds[index] = led_matrix_color(r, g, b);
+    }
+}
+
+void led_matrix_set_word(uint index, led_word_t word) {
+    if (index < LED_COUNT) {
+        leds[index] = word;
+    }
+}
+
+// Multiplica os três canais por scale_q8 / 256: G e B ficam em metades de 16
+// bits de uma mesma palavra (canal * 256 cabe em 16 bits), R vai à parte
+static inline led_word_t scale_word(led_word_t w, uint32_t scale_q8) {
+    uint32_t gb = (w >> 8) & 0x00ff00ffu;
+    uint32_t r = (w >> 16) & 0xffu;
+    gb = ((gb * scale_q8) >> 8) & 0x00ff00ffu;
+    r = (r * scale_q8) >> 8;
+    return (gb << 8) | (r << 16);
+}
+
+uint32_t led_matrix_power_limit(led_word_t *words, uint count) {
+    uint32_t sum = 0;
+    for (uint i = 0; i < count; i++) {
+        led_word_t w = words[i];
+        sum += (w >> 24) + ((w >> 16) & 0xffu) + ((w >> 8) & 0xffu);
+    }
+    uint32_t idle_ma = count * LED_IDLE_MA;
+    uint32_t ma = idle_ma + (sum * LED_CHANNEL_MA + 254) / 255;
+    uint32_t scale = 256;
+    if (ma > LED_POWER_BUDGET_MA) {
+        // Maior fator que mantém os canais dentro do que sobra do limite
+        uint32_t room = LED_POWER_BUDGET_MA > idle_ma ? LED_POWER_BUDGET_MA - idle_ma : 0;
+        scale = room * 255 * 256 / (sum * LED_CHANNEL_MA);
+        for (uint i = 0; i < count; i++)
+            words[i] = scale_word(words[i], scale);
+        power.limited_frames++;
     }
+    power.estimated_ma = ma;
+    power.scale_q8 = scale;
+    return ma;
+}
+
+// Escrito pelo núcleo que envia (núcleo 1); uma leitura no meio de um envio
+// pode misturar dois quadros, o que basta para exibir ou registrar
+void led_matrix_power(led_matrix_power_t *out) {
+    *out = power;
 }
 
 // Inicializa a matriz de LEDs WS2812
+// (chamadas repetidas, como a do núcleo 1 depois dos benchmarks, não fazem nada)
 void led_matrix_init(void) {
+    if (initialized)
+        return;
+    initialized = true;
     uint offset = pio_add_program(pio0, &ws2812b_program); // Carrega o programa PIO
     np_pio = pio0;
-    sm = pio_claim_unused_sm(np_pio, true); // Obtém uma máquina de estado livre
+    sm = pio_claim_unused_sm(np_pio, true); // Obtém uma máquina de estados livre
     ws2812b_program_init(np_pio, sm, offset, MATRIX_LED_PIN); // Configura a PIO para comunicação com os LEDs
+
+    // Palavras de 32 bits do buffer para o FIFO de TX, uma a cada pedido da PIO
+    dma_ch = dma_claim_unused_channel(true);
+    dma_config = dma_channel_get_default_config(dma_ch);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_32);
+    channel_config_set_read_increment(&dma_config, true);
+    channel_config_set_write_increment(&dma_config, false);
+    channel_config_set_dreq(&dma_config, pio_get_dreq(np_pio, sm, true));
+
     led_matrix_clear(); // Limpa a matriz inicializando todos os LEDs como apagados
 }
 
@@ -40,37 +136,117 @@ void led_matrix_clear(void) {
 
 // Escreve os dados da matriz de LEDs no barramento WS2812
 void led_matrix_write(void) {
-    uint32_t save = save_and_disable_interrupts(); // Desativa interrupções para evitar conflitos de tempo
-    for (uint i = 0; i < LED_COUNT; i++) {
-        pio_sm_put_blocking(np_pio, sm, rgb_to_grb(leds[i].R, leds[i].G, leds[i].B)); // Envia dados ao LED
+    led_matrix_send(leds);
+}
+
+// Copia o buffer de cores (para publicar um quadro a outro núcleo, ver output.c)
+void led_matrix_copy(led_word_t *dst) {
+    memcpy(dst, leds, sizeof(leds));
+}
+
+void led_matrix_set_done_callback(led_matrix_done_cb_t cb, void *ctx) {
+    done_ctx = ctx;
+    done_cb = cb;
+}
+
+bool led_matrix_busy(void) {
+    return atomic_load(&state) != LEDS_IDLE;
+}
+
+// Dispara a DMA do buffer buf; retorna o tempo até o quadro estar travado na fita
+static uint32_t start_frame(uint buf) {
+    frame_started_us[buf] = time_us_32();
+    dma_channel_configure(dma_ch, &dma_config, &np_pio->txf[sm], frames[buf], frame_len[buf], true);
+    return frame_len[buf] * LED_US_PER_LED + LED_RESET_US;
+}
+
+// Fim do quadro em envio: libera o buffer ou inicia o pendente (o próprio alarme
+// é reagendado para o fim dele)
+static int64_t frame_done(alarm_id_t id, void *arg) {
+    (void)id;
+    (void)arg;
+    if (dma_channel_is_busy(dma_ch))
+        return -LED_US_PER_LED; // A DMA atrasou (barramento ocupado): espera mais um LED
+    uint done = atomic_load(&front);
+    int64_t again = 0;
+    for (;;) {
+        uint s = atomic_load(&state);
+        if (s == LEDS_BUSY && atomic_compare_exchange_weak(&state, &s, LEDS_IDLE))
+            break;
+        if (s == LEDS_PENDING && atomic_compare_exchange_weak(&state, &s, LEDS_STARTING)) {
+            atomic_store(&front, done ^ 1);
+            again = -(int64_t)start_frame(done ^ 1);
+            atomic_store(&state, LEDS_BUSY);
+            break;
+        }
+    }
+    if (done_cb)
+        done_cb(frame_started_us[done], done_ctx);
+    return again;
+}
+
+// Sem alarme livre: espera aqui a DMA e a trava (menos de 1 ms com a matriz)
+// antes de liberar a fita, para o próximo envio não reconfigurar o canal ocupado
+static void finish_frame_blocking(uint buf) {
+    while (dma_channel_is_busy(dma_ch))
+        tight_loop_contents();
+    busy_wait_us_32(LED_RESET_US);
+    atomic_store(&state, LEDS_IDLE);
+    if (done_cb)
+        done_cb(frame_started_us[buf], done_ctx);
+}
+
+// Escreve um quadro de cores qualquer no barramento WS2812
+void led_matrix_send(const led_word_t *words) {
+    led_matrix_send_chain(words, LED_COUNT);
+}
+
+// Copia e limita o quadro no buffer de trás e o envia: na hora, se a fita está livre,
+// ou ao fim do quadro em curso (um quadro pendente ainda não iniciado é
+// substituído por este). Retorna sem esperar a transmissão.
+void led_matrix_send_chain(const led_word_t *words, uint count) {
+    if (count > LED_CHAIN_MAX)
+        count = LED_CHAIN_MAX;
+
+    // Retoma o buffer de trás se ele esperava o alarme; se o alarme já o estiver
+    // iniciando (só acontece com ele no outro núcleo), espera a troca terminar
+    uint s = LEDS_PENDING;
+    atomic_compare_exchange_strong(&state, &s, LEDS_BUSY);
+    while (atomic_load(&state) == LEDS_STARTING)
+        tight_loop_contents();
+
+    uint back = atomic_load(&front) ^ 1;
+    memcpy(frames[back], words, count * sizeof(led_word_t));
+    led_matrix_power_limit(frames[back], count);
+    frame_len[back] = count;
+
+    for (;;) {
+        s = atomic_load(&state);
+        if (s == LEDS_BUSY && atomic_compare_exchange_weak(&state, &s, LEDS_PENDING))
+            return;
+        if (s == LEDS_IDLE && atomic_compare_exchange_weak(&state, &s, LEDS_BUSY)) {
+            atomic_store(&front, back);
+            if (add_alarm_in_us(start_frame(back), frame_done, NULL, true) < 0)
+                finish_frame_blocking(back);
+            return;
+        }
     }
-    busy_wait_us(300); // Aguarda tempo necessário para atualização correta dos LEDs
-    restore_interrupts(save); // Restaura as interrupções
 }
 
-// Exibe um número de 0 a 9 na matriz de LEDs 5x5
+// Exibe um número de 0 a 9 na matriz de LEDs 5x5, centralizado, em branco no
+// brilho global (números maiores rolam com led_marquee.h)
 void led_matrix_display_number(int number) {
     led_matrix_clear(); // Limpa a matriz antes de exibir um novo número
-
-    // Definição de padrões para exibição dos números de 0 a 9 na matriz 5x5
-    static const uint numbers[10][5][5] = {
-        {{0, 1, 1, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 1, 1, 0}}, // 0
-        {{0, 1, 1, 1, 0}, {0, 0, 1, 0, 0}, {0, 0, 1, 0, 0}, {0, 1, 1, 0, 0}, {0, 0, 1, 0, 0}}, // 1
-        {{0, 1, 1, 1, 0}, {0, 1, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 1, 0, 1, 0}, {0, 0, 1, 0, 0}}, // 2
-        {{0, 1, 1, 1, 0}, {0, 0, 0, 1, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}, {0, 1, 1, 1, 0}}, // 3
-        {{0, 1, 0, 0, 0}, {0, 0, 0, 1, 0}, {0, 1, 1, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 0, 1, 0}}, // 4
-        {{0, 1, 1, 1, 0}, {0, 0, 0, 1, 0}, {0, 1, 1, 1, 0}, {0, 1, 0, 0, 0}, {0, 1, 1, 1, 0}}, // 5
-        {{0, 1, 1, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 1, 1, 0}, {0, 1, 0, 0, 0}, {0, 1, 1, 1, 0}}, // 6
-        {{0, 1, 0, 0, 0}, {0, 0, 0, 1, 0}, {0, 1, 0, 0, 0}, {0, 0, 0, 1, 0}, {0, 1, 1, 1, 0}}, // 7
-        {{0, 1, 1, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 1, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 1, 1, 0}}, // 8
-        {{0, 1, 1, 1, 0}, {0, 0, 0, 1, 0}, {0, 1, 1, 1, 0}, {0, 1, 0, 1, 0}, {0, 1, 1, 1, 0}}  // 9
-    };
-
-    // Percorre a matriz 5x5 e ativa os LEDs correspondentes ao número
-    for (uint i = 0; i < 5; i++) {
-        for (uint j = 0; j < 5; j++) {
-            if (numbers[number][i][j]) { 
-                led_matrix_set_pixel(map_index(i, j), 255, 255, 255); // Define os LEDs como branco
+    if (number >= 0 && number <= 9) {
+        uint width;
+        const uint8_t *cols = led_font_glyph('0' + number, &width);
+        uint x0 = (COLS - width) / 2;
+        led_word_t white = led_matrix_color(255, 255, 255);
+        for (uint x = 0; x < width; x++) {
+            for (uint row = 0; row < ROWS; row++) {
+                if (cols[x] & (1u << row)) {
+                    leds[led_matrix_index(row, x0 + x)] = white;
+                }
             }
         }
     }
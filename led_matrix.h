@@ -9,7 +9,7 @@
 #include "hardware/clocks.h"
 #include "hardware/irq.h"
 #include "hardware/timer.h"
-#include "hardware/sync.h"
+#include "hardware/dma.h"
 #include "ws2812b.pio.h"
 
 #define MATRIX_LED_PIN 7
@@ -17,17 +17,60 @@
 #define ROWS 5
 #define COLS 5
 
-// Estrutura do LED GRB
+// Maior cadeia aceita por led_matrix_send_chain (a matriz usa LED_COUNT); pode ser
+// aumentada na compilação para fitas maiores (2 buffers de 4 bytes por LED)
+#ifndef LED_CHAIN_MAX
+#define LED_CHAIN_MAX LED_COUNT
+#endif
+
+#define LED_US_PER_LED 30   // 24 bits a 800 kHz (programa ws2812b.pio a 8 MHz, 10 ciclos por bit)
+#define LED_RESET_US 300    // Linha em nível baixo que trava o quadro na fita (WS2812B: > 280 us)
+
+// Modelo de consumo do WS2812B: corrente proporcional ao ciclo de trabalho de
+// cada canal, mais o controlador de cada LED
+#define LED_CHANNEL_MA 12   // Um canal em 255
+#define LED_IDLE_MA 1       // Por LED, mesmo apagado
+
+// Corrente máxima estimada de um quadro; acima dela o quadro inteiro é atenuado
+#ifndef LED_POWER_BUDGET_MA
+#define LED_POWER_BUDGET_MA 300
+#endif
+
+// Cor de um LED já pronta para o FIFO da PIO: G, R e B nos bytes 3, 2 e 1 (a
+// PIO desloca 24 bits a partir do bit 31), depois da gama e do brilho global
+typedef uint32_t led_word_t;
+
+// Consumo do último quadro enviado
 typedef struct {
-    uint8_t G, R, B;
-} pixel_t;
+    uint32_t estimated_ma;      // Antes da limitação
+    uint32_t scale_q8;          // Fator aplicado (256 = sem atenuação)
+    uint32_t limited_frames;    // Quadros atenuados desde o início
+} led_matrix_power_t;
 
-typedef pixel_t npLED_t;
+// Chamado (na interrupção do alarme, núcleo 0) quando um quadro foi travado na
+// fita; started_us é o time_us_32() do início da DMA desse quadro
+typedef void (*led_matrix_done_cb_t)(uint32_t started_us, void *ctx);
 
 void led_matrix_init(void);
 void led_matrix_clear(void);
 void led_matrix_write(void);
+void led_matrix_copy(led_word_t *dst);
+void led_matrix_send(const led_word_t *words);
+void led_matrix_send_chain(const led_word_t *words, uint count);
+bool led_matrix_busy(void);
+void led_matrix_set_done_callback(led_matrix_done_cb_t cb, void *ctx);
 void led_matrix_set_pixel(uint index, uint8_t r, uint8_t g, uint8_t b);
+void led_matrix_set_word(uint index, led_word_t word);
+uint led_matrix_index(uint row, uint col);
+
+// Aplica a tabela de gama e brilho (led_lut.h) e monta a palavra do FIFO
+led_word_t led_matrix_color(uint8_t r, uint8_t g, uint8_t b);
+
+// Estima a corrente do quadro e, acima de LED_POWER_BUDGET_MA, atenua todas as
+// cores na mesma proporção. Chamada por led_matrix_send_chain no buffer da DMA;
+// retorna a corrente estimada antes da atenuação.
+uint32_t led_matrix_power_limit(led_word_t *words, uint count);
+void led_matrix_power(led_matrix_power_t *out);
 void led_matrix_display_number(int number);
 
 #endif // LED_MATRIX_H
@@ -0,0 +1,188 @@
+#include <stdlib.h>
+#include "list_view.h"
+
+#define ROW LIST_VIEW_ROW_HEIGHT
+
+// Faixa auxiliar de um item (duas páginas), desenhada com as primitivas do OLED
+static uint8_t strip_buffer[1 + WIDTH * ROW / 8];
+static ssd1306_t strip;
+
+static int max_scroll(const list_view_t *lv) {
+    int max = lv->count * ROW - HEIGHT;
+    return max > 0 ? max : 0;
+}
+
+// Menor rolagem a partir do destino atual que deixa o item index inteiro na tela
+static int target_for(const list_view_t *lv, int index) {
+    int target = lv->target_px;
+    int y = index * ROW;
+    if (y < target)
+        target = y;
+    else if (y + ROW > target + HEIGHT)
+        target = y + ROW - HEIGHT;
+    if (target > max_scroll(lv))
+        target = max_scroll(lv);
+    return target < 0 ? 0 : target;
+}
+
+// Setas da janela em repouso: "^" no item do topo se há item acima da seleção,
+// "v" no item de baixo se há item abaixo (inclusive sobre linhas vazias)
+static int wanted_arrow_up(const list_view_t *lv) {
+    return lv->count > 1 && lv->selected > 0 ? lv->scroll_px / ROW : -1;
+}
+
+static int wanted_arrow_down(const list_view_t *lv) {
+    return lv->count > 1 && lv->selected < lv->count - 1 ? lv->scroll_px / ROW + LIST_VIEW_ROWS - 1 : -1;
+}
+
+// Item inteiro a partir da linha y de target (o ram_buffer na faixa do item, ou a faixa auxiliar)
+static void paint_item(const list_view_t *lv, ssd1306_t *target, int item, int y) {
+    ssd1306_fill_rect(target, y, 0, WIDTH, ROW, SSD1306_CLEAR);
+    if (item < lv->count) {
+        ssd1306_draw_string(target, lv->label(lv->ctx, item), 5, y + 4);
+        if (item == lv->selected)
+            ssd1306_rect(target, y, 0, WIDTH, ROW, true, false);
+    }
+    if (item == lv->arrow_up)
+        ssd1306_draw_string(target, "^", 60, y);
+    if (item == lv->arrow_down)
+        ssd1306_draw_string(target, "v", 60, y + ROW - 8);
+}
+
+// Desenha as linhas row0..row1-1 do item na sua faixa da GDDRAM
+static void draw_item(list_view_t *lv, int item, int row0, int row1) {
+    int base = (item * ROW) % HEIGHT;
+    lv->changed = true;
+    if (row0 == 0 && row1 == ROW) {
+        paint_item(lv, lv->ssd, item, base);
+        return;
+    }
+
+    // Item em parte na tela: a outra parte da faixa ainda mostra o item que sai
+    paint_item(lv, &strip, item, 0);
+    for (int p = 0; p < ROW / 8; p++) {
+        int a = row0 > p * 8 ? row0 : p * 8;
+        int b = row1 < p * 8 + 8 ? row1 : p * 8 + 8;
+        if (a >= b)
+            continue;
+        uint8_t mask = (uint8_t)(((1u << (b - a)) - 1) << (a - p * 8));
+        ssd1306_blit_page(lv->ssd, (uint8_t)(base / 8 + p), &strip_buffer[1 + p * WIDTH], mask);
+    }
+}
+
+// Desenha as linhas y0..y1-1 do conteúdo (item i nas linhas i * ROW ...)
+static void draw_band(list_view_t *lv, int y0, int y1) {
+    for (int item = y0 / ROW; item * ROW < y1; item++) {
+        int top = item * ROW;
+        draw_item(lv, item, (y0 > top ? y0 : top) - top, (y1 < top + ROW ? y1 : top + ROW) - top);
+    }
+}
+
+// Só a parte do item que está na tela
+static void draw_visible(list_view_t *lv, int item) {
+    if (item < 0)
+        return;
+    int y0 = item * ROW > lv->scroll_px ? item * ROW : lv->scroll_px;
+    int y1 = item * ROW + ROW < lv->scroll_px + HEIGHT ? item * ROW + ROW : lv->scroll_px + HEIGHT;
+    if (y0 < y1)
+        draw_band(lv, y0, y1);
+}
+
+static void update_arrows(list_view_t *lv) {
+    int up = wanted_arrow_up(lv);
+    int down = wanted_arrow_down(lv);
+    if (up != lv->arrow_up) {
+        int old = lv->arrow_up;
+        lv->arrow_up = up;
+        draw_visible(lv, old);
+        draw_visible(lv, up);
+    }
+    if (down != lv->arrow_down) {
+        int old = lv->arrow_down;
+        lv->arrow_down = down;
+        draw_visible(lv, old);
+        draw_visible(lv, down);
+    }
+}
+
+static bool step_due(const list_view_t *lv) {
+    return lv->scroll_px != lv->target_px && time_us_32() - lv->step_us >= LIST_VIEW_STEP_US;
+}
+
+void list_view_init(list_view_t *lv, ssd1306_t *ssd, list_view_label_fn label, void *ctx) {
+    *lv = (list_view_t){.ssd = ssd, .label = label, .ctx = ctx, .arrow_up = -1, .arrow_down = -1};
+    ssd1306_init_surface(&strip, strip_buffer, WIDTH, ROW);
+}
+
+void list_view_set(list_view_t *lv, int count, int selected) {
+    lv->count = count;
+    lv->selected = selected;
+    lv->target_px = 0;
+    lv->target_px = lv->scroll_px = target_for(lv, selected);
+    lv->valid = false;
+}
+
+void list_view_select(list_view_t *lv, int index) {
+    if (index == lv->selected)
+        return;
+    int old = lv->selected;
+    lv->selected = index;
+    lv->target_px = target_for(lv, index);
+    if (abs(lv->target_px - lv->scroll_px) > HEIGHT) {
+        // Salto maior que a tela (da última opção para a primeira): sem animação
+        lv->scroll_px = lv->target_px;
+        lv->valid = false;
+    }
+    if (lv->valid) {
+        draw_visible(lv, old);
+        draw_visible(lv, index);
+    }
+}
+
+void list_view_invalidate(list_view_t *lv) {
+    lv->valid = false;
+    ssd1306_set_start_line(lv->ssd, 0); // Telas por cima da lista desenham a partir da linha 0
+}
+
+bool list_view_pending(const list_view_t *lv) {
+    if (!lv->valid || lv->changed || step_due(lv))
+        return true;
+    return lv->scroll_px == lv->target_px &&
+           (wanted_arrow_up(lv) != lv->arrow_up || wanted_arrow_down(lv) != lv->arrow_down);
+}
+
+bool list_view_render(list_view_t *lv) {
+    if (!lv->valid) {
+        lv->scroll_px = lv->target_px;
+        lv->arrow_up = wanted_arrow_up(lv);
+        lv->arrow_down = wanted_arrow_down(lv);
+        draw_band(lv, lv->scroll_px, lv->scroll_px + HEIGHT);
+        ssd1306_set_start_line(lv->ssd, (uint8_t)(lv->scroll_px % HEIGHT));
+        lv->valid = true;
+        lv->changed = false;
+        return true;
+    }
+
+    if (step_due(lv)) {
+        // Só as linhas que entram na tela; a linha inicial segue com o mesmo quadro
+        int from = lv->scroll_px;
+        int delta = lv->target_px - from;
+        if (delta > LIST_VIEW_STEP_PX)
+            delta = LIST_VIEW_STEP_PX;
+        else if (delta < -LIST_VIEW_STEP_PX)
+            delta = -LIST_VIEW_STEP_PX;
+        lv->scroll_px = from + delta;
+        if (delta > 0)
+            draw_band(lv, from + HEIGHT, lv->scroll_px + HEIGHT);
+        else
+            draw_band(lv, lv->scroll_px, from);
+        ssd1306_set_start_line(lv->ssd, (uint8_t)(lv->scroll_px % HEIGHT));
+        lv->step_us = time_us_32();
+    }
+    if (lv->scroll_px == lv->target_px)
+        update_arrows(lv);
+
+    bool changed = lv->changed;
+    lv->changed = false;
+    return changed;
+}
@@ -0,0 +1,62 @@
+#ifndef LIST_VIEW_H
+#define LIST_VIEW_H
+
+// Lista rolável de itens de uma linha sobre o OLED. Só os itens da janela
+// visível são desenhados, e os textos vêm de um callback, então memória e custo
+// de desenho não dependem do tamanho da lista.
+//
+// A rolagem usa a linha inicial do SSD1306 (SET_DISP_START_LINE) em vez de
+// redesenhar a tela: a GDDRAM vira um anel de HEIGHT linhas, o item i ocupa
+// as linhas (i * LIST_VIEW_ROW_HEIGHT) % HEIGHT e a linha do conteúdo no topo
+// do painel é a linha inicial. Cada passo da animação desenha só as linhas que
+// entram na tela; como o anel não tem linhas sobrando, o item que entra divide
+// a faixa com o que sai, e cada item é desenhado numa faixa auxiliar de duas
+// páginas e copiado com máscara só nas linhas expostas.
+//
+// Quem desenha a tela inteira por cima da lista (as telas de ação) deve chamar
+// list_view_invalidate antes, o que volta a linha inicial a 0.
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+#define LIST_VIEW_ROW_HEIGHT 16                                 // Divide HEIGHT e é múltiplo de 8
+#define LIST_VIEW_ROWS (HEIGHT / LIST_VIEW_ROW_HEIGHT)          // Itens inteiros na tela
+#define LIST_VIEW_STEP_PX 4                                     // Linhas por passo da animação
+#define LIST_VIEW_STEP_US 20000                                 // Intervalo entre passos
+
+typedef const char *(*list_view_label_fn)(void *ctx, int index);
+
+typedef struct {
+    ssd1306_t *ssd;
+    list_view_label_fn label;
+    void *ctx;
+    int count;
+    int selected;
+    int scroll_px;          // Linha do conteúdo no topo do painel
+    int target_px;          // Destino da animação (múltiplo de LIST_VIEW_ROW_HEIGHT)
+    int arrow_up;           // Item com a seta "^" desenhada (-1: nenhum)
+    int arrow_down;         // Item com a seta "v" desenhada (-1: nenhum)
+    uint32_t step_us;       // Instante do último passo da animação
+    bool valid;             // false: redesenha a janela inteira
+    bool changed;           // O ram_buffer mudou desde o último list_view_render
+} list_view_t;
+
+void list_view_init(list_view_t *lv, ssd1306_t *ssd, list_view_label_fn label, void *ctx);
+
+// Novo conteúdo: redesenha a janela com o item selecionado visível, sem animação
+void list_view_set(list_view_t *lv, int count, int selected);
+
+// Move a seleção; a janela rola (animada) até o item ficar visível
+void list_view_select(list_view_t *lv, int index);
+
+void list_view_invalidate(list_view_t *lv);
+
+// true se list_view_render tem algo a desenhar agora
+bool list_view_pending(const list_view_t *lv);
+
+// Desenha o que mudou e avança a animação. Retorna true se o ram_buffer mudou
+// (o quadro deve ser publicado).
+bool list_view_render(list_view_t *lv);
+
+#endif // LIST_VIEW_H
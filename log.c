@@ -0,0 +1,194 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "log.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#include "hardware/sync.h"
+
+// Início da seção com as strings de formato (símbolo gerado pelo ligador); o id
+// de um formato é a sua distância até aqui, igual no ELF e em execução
+extern const char __start_log_fmt[];
+
+// Um anel por núcleo. O produtor é o próprio núcleo (loop e interrupções, que
+// mascaram as IRQs só durante a cópia); o consumidor é log_drain no núcleo 0.
+// Cada lado escreve apenas o próprio índice.
+typedef struct {
+    uint32_t words[LOG_RING_WORDS];
+    _Atomic uint32_t head;      // Escrito pelo produtor
+    _Atomic uint32_t tail;      // Escrito pelo consumidor
+    _Atomic uint32_t dropped;   // Registros descartados com o anel cheio
+} log_ring_t;
+
+static log_ring_t rings[2];
+static uint32_t dropped_reported;
+
+uint8_t log_levels[LOG_MODULE_COUNT] = {
+    [0 ... LOG_MODULE_COUNT - 1] = LOG_LEVEL_DEFAULT
+};
+
+void log_set_level(log_module_t module, uint8_t level) {
+    if (module < LOG_MODULE_COUNT)
+        log_levels[module] = level > LOG_DEBUG ? LOG_DEBUG : level;
+}
+
+uint8_t log_level(log_module_t module) {
+    return module < LOG_MODULE_COUNT ? log_levels[module] : LOG_ERROR;
+}
+
+uint32_t log_dropped(void) {
+    return atomic_load_explicit(&rings[0].dropped, memory_order_relaxed) +
+           atomic_load_explicit(&rings[1].dropped, memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Montagem do registro (na pilha de quem chama)
+
+void log_begin(log_record_t *r, const char *fmt, uint8_t level, uint8_t module) {
+    r->words[0] = (uint32_t)(fmt - __start_log_fmt) & 0xFFFFu;
+    r->words[0] |= (uint32_t)(module & 0xFu) << 16 | (uint32_t)(level & 0x3u) << 20 |
+                   (uint32_t)(get_core_num() & 1u) << 22;
+    r->words[1] = time_us_32();
+    r->count = 2;
+}
+
+void log_put_u32(log_record_t *r, uint32_t value) {
+    if (r->count < count_of(r->words))
+        r->words[r->count++] = value;
+}
+
+void log_put_u64(log_record_t *r, uint64_t value) {
+    log_put_u32(r, (uint32_t)value);
+    log_put_u32(r, (uint32_t)(value >> 32));
+}
+
+void log_put_float(log_record_t *r, double value) {
+    float f = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    log_put_u32(r, bits);
+}
+
+void log_put_str(log_record_t *r, const char *str) {
+    size_t len = str ? strnlen(str, LOG_MAX_STR) : 0;
+    uint32_t words = (uint32_t)(len + 3) / 4;
+    if (r->count + 1 + words > count_of(r->words))
+        len = words = 0; // Sem espaço: o decodificador mostra uma string vazia
+    r->words[r->count++] = (uint32_t)len;
+    memset(&r->words[r->count], 0, words * 4);
+    memcpy(&r->words[r->count], str, len);
+    r->count += words;
+}
+
+void log_commit(log_record_t *r) {
+    r->words[0] |= (r->count - 2) << 24;
+    log_ring_t *ring = &rings[get_core_num()];
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (LOG_RING_WORDS - (head - tail) < r->count) {
+        atomic_store_explicit(&ring->dropped,
+                              atomic_load_explicit(&ring->dropped, memory_order_relaxed) + 1,
+                              memory_order_relaxed);
+    } else {
+        for (uint32_t i = 0; i < r->count; i++)
+            ring->words[(head + i) & (LOG_RING_WORDS - 1)] = r->words[i];
+        atomic_store_explicit(&ring->head, head + r->count, memory_order_release);
+    }
+    restore_interrupts(irq);
+}
+
+// ---------------------------------------------------------------------------
+// Envio
+
+// COBS: o registro sai sem bytes 0x00 e é delimitado por 0x00 dos dois lados.
+// Retorna o tamanho do quadro em out.
+static uint32_t cobs_encode(const uint8_t *data, uint32_t len, uint8_t *out) {
+    uint32_t n = 0;
+    out[n++] = 0;
+    uint32_t block_start = 0;
+    while (block_start <= len) {
+        uint32_t end = block_start;
+        while (end < len && data[end] != 0 && end - block_start < 254)
+            end++;
+        out[n++] = (uint8_t)(end - block_start + 1);
+        memcpy(&out[n], &data[block_start], end - block_start);
+        n += end - block_start;
+        // Um zero consumido encerra o bloco; um bloco cheio (254) não consome nada
+        block_start = (end < len && data[end] == 0) ? end + 1 : end;
+        if (end == len)
+            break;
+    }
+    out[n++] = 0;
+    return n;
+}
+
+// Com o quadro inteiro no FIFO de TX, o stdio da USB não espera
+// (PICO_STDIO_USB_STDOUT_TIMEOUT_US) nem corta o quadro no meio
+bool log_write_frame(const uint8_t *data, uint32_t len) {
+    static uint8_t frame[LOG_FRAME_MAX + LOG_FRAME_MAX / 254 + 3];
+    if (len > LOG_FRAME_MAX)
+        return false;
+    uint32_t n = cobs_encode(data, len, frame);
+    if (tud_cdc_write_available() < n)
+        return false;
+    for (uint32_t i = 0; i < n; i++)
+        putchar_raw(frame[i]);
+    return true;
+}
+
+// Copia o registro mais antigo do anel sem liberá-lo; false se o anel está vazio
+static bool peek_record(log_ring_t *ring, log_record_t *r) {
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (head == tail)
+        return false;
+    uint32_t header = ring->words[tail & (LOG_RING_WORDS - 1)];
+    r->count = 2 + (header >> 24);
+    for (uint32_t i = 0; i < r->count; i++)
+        r->words[i] = ring->words[(tail + i) & (LOG_RING_WORDS - 1)];
+    return true;
+}
+
+static void release_record(log_ring_t *ring, const log_record_t *r) {
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, tail + r->count, memory_order_release);
+}
+
+static bool pending(void) {
+    for (uint core = 0; core < 2; core++)
+        if (atomic_load_explicit(&rings[core].head, memory_order_acquire) !=
+            atomic_load_explicit(&rings[core].tail, memory_order_relaxed))
+            return true;
+    return false;
+}
+
+// Sem terminal aberto, ou com o FIFO de TX cheio, a USB não é escrita (os
+// registros esperam no anel e, com ele cheio, os novos são descartados)
+bool log_drain(void) {
+    if (!stdio_usb_connected())
+        return false;
+
+    uint32_t dropped = log_dropped();
+    if (dropped != dropped_reported) {
+        LOG_W(LOG_SYS, "log: %lu registros descartados", (unsigned long)(dropped - dropped_reported));
+        dropped_reported = dropped;
+    }
+
+    log_record_t r;
+    for (uint sent = 0; sent < LOG_DRAIN_RECORDS;) {
+        bool any = false;
+        for (uint core = 0; core < 2 && sent < LOG_DRAIN_RECORDS; core++) {
+            if (!peek_record(&rings[core], &r))
+                continue;
+            // FIFO de TX cheio: o registro fica no anel até o computador ler
+            if (!log_write_frame((const uint8_t *)r.words, r.count * 4))
+                return false;
+            release_record(&rings[core], &r);
+            sent++;
+            any = true;
+        }
+        if (!any)
+            break;
+    }
+    return pending();
+}
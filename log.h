@@ -0,0 +1,131 @@
+#ifndef LOG_H
+#define LOG_H
+
+// Log binário adiado: LOG_* grava o identificador da string de formato e os
+// argumentos crus num anel sem travas (um por núcleo) e retorna; nada é
+// formatado no firmware. log_drain envia os registros pela USB quando o loop
+// principal está ocioso, e tools/log_decode.py remonta o texto a partir das
+// strings guardadas na seção log_fmt do ELF. Com o anel cheio o registro é
+// descartado e contado, nunca bloqueia; com o computador sem ler, os registros
+// esperam no anel em vez de travar a escrita na USB.
+//
+// Registro no anel (palavras de 32 bits):
+//   [0] id do formato (16) | módulo (4) << 16 | nível (2) << 20 | núcleo (1) << 22 | palavras de argumento (8) << 24
+//   [1] time_us_32()
+//   [2..] argumentos: inteiros em 1 palavra, long long em 2, float/double como float em 1,
+//         strings como tamanho + bytes (até LOG_MAX_STR)
+// Na USB cada registro sai codificado em COBS entre bytes 0x00, de modo que o
+// texto comum (trace_dump, benchmarks) pode continuar no mesmo fluxo. Quadros
+// com o módulo LOG_MODULE_FRAME no cabeçalho não são registros (ver mirror.h).
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#define LOG_RING_WORDS 1024     // Por núcleo (potência de 2)
+#define LOG_MAX_ARG_WORDS 16
+#define LOG_MAX_STR 32          // Bytes copiados de cada argumento %s
+#define LOG_DRAIN_RECORDS 8     // Registros enviados por chamada de log_drain
+#define LOG_FRAME_MAX 160       // Maior quadro de log_write_frame, antes do COBS
+
+// Níveis
+#define LOG_ERROR 0
+#define LOG_WARN 1
+#define LOG_INFO 2
+#define LOG_DEBUG 3
+
+// Nível máximo compilado: chamadas acima dele não geram código
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX LOG_DEBUG
+#endif
+
+// Nível inicial de todos os módulos (ajustável em execução com log_set_level)
+#ifndef LOG_LEVEL_DEFAULT
+#define LOG_LEVEL_DEFAULT LOG_INFO
+#endif
+
+// Módulos (mesma ordem da lista MODULES de tools/log_decode.py)
+typedef enum {
+    LOG_SYS,
+    LOG_MENU,
+    LOG_INPUT,
+    LOG_OLED,
+    LOG_OUTPUT,
+    LOG_MODULE_COUNT
+} log_module_t;
+
+#define LOG_MODULE_FRAME 0xF    // Reservado: quadros de outros produtores no mesmo fluxo
+
+typedef struct {
+    uint32_t words[2 + LOG_MAX_ARG_WORDS];
+    uint32_t count;
+} log_record_t;
+
+extern uint8_t log_levels[LOG_MODULE_COUNT];
+
+void log_set_level(log_module_t module, uint8_t level);
+uint8_t log_level(log_module_t module);
+uint32_t log_dropped(void);
+
+// Consumidor (núcleo 0, loop principal): envia até LOG_DRAIN_RECORDS registros.
+// Retorna true se ainda há registros que poderiam ser enviados agora.
+bool log_drain(void);
+
+// Envia data (até LOG_FRAME_MAX bytes) como um quadro COBS entre bytes 0x00
+// (núcleo 0). O quadro só é escrito se couber inteiro no FIFO de TX do CDC, de
+// modo que a escrita nunca espera o computador; retorna false sem escrever nada
+// se não couber.
+bool log_write_frame(const uint8_t *data, uint32_t len);
+
+// Usadas pelas macros
+void log_begin(log_record_t *r, const char *fmt, uint8_t level, uint8_t module);
+void log_put_u32(log_record_t *r, uint32_t value);
+void log_put_u64(log_record_t *r, uint64_t value);
+void log_put_float(log_record_t *r, double value);
+void log_put_str(log_record_t *r, const char *str);
+void log_commit(log_record_t *r);
+
+// Tipo de cada argumento escolhido em tempo de compilação
+#define LOG_PUT(r, x) _Generic((x),                                        \
+    char *: log_put_str,                                                   \
+    const char *: log_put_str,                                             \
+    float: log_put_float,                                                  \
+    double: log_put_float,                                                 \
+    long long: log_put_u64,                                                \
+    unsigned long long: log_put_u64,                                       \
+    default: log_put_u32)((r), (x))
+
+// Aplica LOG_PUT a até 6 argumentos
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, n, ...) n
+#define LOG_NARGS(...) LOG_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_CAT_(a, b) a##b
+#define LOG_CAT(a, b) LOG_CAT_(a, b)
+#define LOG_PUT_0(r)
+#define LOG_PUT_1(r, a) LOG_PUT(r, a);
+#define LOG_PUT_2(r, a, ...) LOG_PUT(r, a); LOG_PUT_1(r, __VA_ARGS__)
+#define LOG_PUT_3(r, a, ...) LOG_PUT(r, a); LOG_PUT_2(r, __VA_ARGS__)
+#define LOG_PUT_4(r, a, ...) LOG_PUT(r, a); LOG_PUT_3(r, __VA_ARGS__)
+#define LOG_PUT_5(r, a, ...) LOG_PUT(r, a); LOG_PUT_4(r, __VA_ARGS__)
+#define LOG_PUT_6(r, a, ...) LOG_PUT(r, a); LOG_PUT_5(r, __VA_ARGS__)
+
+// O formato é uma string literal guardada na seção log_fmt; o printf morto só
+// existe para o compilador conferir os argumentos contra o formato
+#define LOG_AT(level, module, fmt, ...)                                               \
+    do {                                                                              \
+        if ((level) <= LOG_LEVEL_MAX && (level) <= log_levels[(module)]) {            \
+            static const char log_fmt_[] __attribute__((section("log_fmt"), used)) = fmt; \
+            log_record_t log_r_;                                                      \
+            log_begin(&log_r_, log_fmt_, (level), (module));                          \
+            LOG_CAT(LOG_PUT_, LOG_NARGS(__VA_ARGS__))(&log_r_, ##__VA_ARGS__)         \
+            log_commit(&log_r_);                                                      \
+        }                                                                             \
+        if (0)                                                                        \
+            printf(fmt, ##__VA_ARGS__);                                               \
+    } while (0)
+
+#define LOG_E(module, fmt, ...) LOG_AT(LOG_ERROR, module, fmt, ##__VA_ARGS__)
+#define LOG_W(module, fmt, ...) LOG_AT(LOG_WARN, module, fmt, ##__VA_ARGS__)
+#define LOG_I(module, fmt, ...) LOG_AT(LOG_INFO, module, fmt, ##__VA_ARGS__)
+#define LOG_D(module, fmt, ...) LOG_AT(LOG_DEBUG, module, fmt, ##__VA_ARGS__)
+
+#endif // LOG_H
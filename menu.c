@@ -0,0 +1,533 @@
+// Menu do OLED: navegação pela árvore de menu.txt, lista do submenu exibido
+// e telas das ações. O main (BitDogLab-Menu.c) e os benchmarks ligam este
+// módulo.
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "menu.h"
+#include "input.h"
+#include "output.h"
+#include "trace.h"
+#include "log.h"
+#include "menu_tables.h"
+#include "screen.h"
+#include "sched.h"
+#include "temperature.h"
+#include "led_marquee.h"
+#include "power.h"
+#include "list_view.h"
+// Trecho para modo BOOTSEL com Botão B
+#include "pico/bootrom.h"
+
+// Configurações do OLED
+#define I2C_PORT i2c1
+#define I2C_SDA 14
+#define I2C_SCL 15
+#define ENDERECO 0x3C
+
+// Clock do barramento I2C do OLED: 400 kHz (Fast-mode) por padrão, até 1 MHz (Fast-mode Plus).
+// Pode ser definido pelo CMake (-DOLED_I2C_FREQ_HZ=1000000). Acima de 400 kHz os pull-ups
+// precisam ser fortes o bastante para o tempo de subida (os internos do RP2040 não bastam).
+#ifndef OLED_I2C_FREQ_HZ
+#define OLED_I2C_FREQ_HZ (400 * 1000)
+#endif
+#if OLED_I2C_FREQ_HZ > 1000000
+#error "OLED_I2C_FREQ_HZ acima de 1 MHz (limite do Fast-mode Plus)"
+#endif
+
+#define MENU_TIMEOUT_US 30000000  // 30 segundos
+#define MENSAGEM_US 2000000       // Tempo na tela das mensagens das ações
+#define ATUALIZACAO_US 1000000    // Período de atualização das telas com dados ao vivo
+
+// Estrutura do OLED
+ssd1306_t ssd;
+
+// Funções internas da navegação
+static void iniciar_lista();
+static void abrir_menu(uint16_t menu, int opcao);
+static void push_menu(uint16_t submenu);
+static void pop_menu();
+
+// Variáveis globais para navegação: o submenu exibido (índice em menu_itens),
+// a opção selecionada e o número de opções do submenu
+int opcao_atual = 0;
+uint16_t menu_atual = MENU_RAIZ;
+int num_opcoes = 0;
+static int tarefa_timeout = SCHED_INVALID; // Volta ao menu principal após MENU_TIMEOUT_US sem interação
+
+// Inicializa o OLED
+void iniciar_oled() {
+    uint64_t inicio = time_us_64();
+    uint baudrate = i2c_init(I2C_PORT, OLED_I2C_FREQ_HZ);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+    if (OLED_I2C_FREQ_HZ > 400 * 1000) {
+        // Fast-mode Plus: bordas de descida mais rápidas com corrente de saída máxima
+        gpio_set_drive_strength(I2C_SDA, GPIO_DRIVE_STRENGTH_12MA);
+        gpio_set_drive_strength(I2C_SCL, GPIO_DRIVE_STRENGTH_12MA);
+        gpio_set_slew_rate(I2C_SDA, GPIO_SLEW_RATE_FAST);
+        gpio_set_slew_rate(I2C_SCL, GPIO_SLEW_RATE_FAST);
+    }
+
+    ssd1306_init(&ssd, 128, 64, false, ENDERECO, I2C_PORT);
+    ssd1306_config(&ssd);
+    ssd1306_fill(&ssd, false);
+    ssd1306_send_data(&ssd); // Primeiro quadro: o painel acabou de ligar, então é sempre completo
+    iniciar_lista();
+
+    LOG_I(LOG_OLED, "OLED: I2C a %u Hz, primeiro quadro em %llu us, quadro completo em %lu us",
+          baudrate, (unsigned long long)(time_us_64() - inicio), (unsigned long)ssd.last_flush_us);
+}
+
+// Animação Inicial (envio síncrono: deve rodar antes de output_init)
+void animacao_inicial() {
+    ssd1306_fill(&ssd, false);
+    for (int i = 0; i < 128; i += 4) {
+        ssd1306_rect(&ssd, i, i, 128 - i * 2, 64 - i * 2, true, false);
+        ssd1306_send_data(&ssd);
+        sleep_ms(50);
+    }
+    ssd1306_fill(&ssd, false);
+    ssd1306_send_data(&ssd);
+}
+
+// Tela de mensagem: duas linhas por MENSAGEM_US (ou até o Botão A)
+typedef struct {
+    const char *linha1;
+    const char *linha2;
+} Mensagem;
+
+static Mensagem mensagem; // Uma mensagem aberta por vez
+
+static void desenhar_mensagem(void *ctx) {
+    const Mensagem *m = ctx;
+    ssd1306_fill(&ssd, false);
+    ssd1306_draw_string(&ssd, m->linha1, 10, 20);
+    if (m->linha2) {
+        ssd1306_draw_string(&ssd, m->linha2, 10, 40);
+    }
+}
+
+// A mensagem também rola na matriz de LEDs enquanto está aberta
+static void abrir_mensagem(void *ctx) {
+    const Mensagem *m = ctx;
+    char texto[LED_MARQUEE_MAX_TEXT + 1];
+    snprintf(texto, sizeof(texto), "%s%s%s", m->linha1, m->linha2 ? " " : "", m->linha2 ? m->linha2 : "");
+    led_marquee_start(texto, led_matrix_color(0, 128, 255), true);
+}
+
+static void fechar_mensagem(void *ctx) {
+    (void)ctx;
+    led_marquee_stop();
+}
+
+static const screen_t tela_mensagem = {
+    .name = "mensagem",
+    .enter = abrir_mensagem,
+    .draw = desenhar_mensagem,
+    .exit = fechar_mensagem,
+    .timeout_us = MENSAGEM_US,
+};
+
+// Exibe mensagem genérica no OLED; retorna imediatamente
+void exibir_mensagem(const char *linha1, const char *linha2) {
+    mensagem = (Mensagem){linha1, linha2};
+    screen_push(&tela_mensagem, &mensagem);
+}
+
+// Item na posição opcao do submenu menu
+static inline const ItemMenu *item_menu(uint16_t menu, int opcao) {
+    return &menu_itens[menu_itens[menu].primeiro_filho + opcao];
+}
+
+// Lista do submenu exibido: só a janela visível é desenhada, e a rolagem usa a
+// linha inicial do OLED (ver list_view.h)
+static list_view_t lista;
+static uint16_t menu_na_lista = 0xFFFF; // Submenu cujos itens estão na lista
+
+static const char *titulo_opcao(void *ctx, int opcao) {
+    (void)ctx;
+    return item_menu(menu_na_lista, opcao)->titulo;
+}
+
+static void iniciar_lista() {
+    list_view_init(&lista, &ssd, titulo_opcao, NULL);
+    menu_na_lista = 0xFFFF;
+}
+
+// Força o redesenho completo do menu na próxima chamada de mostrar_menu
+void invalidar_menu() {
+    list_view_invalidate(&lista);
+}
+
+// Mostra o menu atual; retorna true se algo foi redesenhado
+bool mostrar_menu() {
+    if (screen_active()) {
+        return false; // Uma tela de ação cobre o menu
+    }
+    if (menu_atual != menu_na_lista || num_opcoes != lista.count) {
+        LOG_D(LOG_MENU, "Desenhando menu com %d opcoes", num_opcoes);
+        menu_na_lista = menu_atual;
+        list_view_set(&lista, num_opcoes, opcao_atual);
+    } else {
+        list_view_select(&lista, opcao_atual);
+    }
+    if (!list_view_pending(&lista)) {
+        return false; // Tela ociosa: nenhum desenho e nenhum tráfego I2C
+    }
+
+    TRACE_BEGIN(TRACE_DRAW_MENU);
+    bool mudou = list_view_render(&lista);
+    TRACE_END(TRACE_DRAW_MENU);
+    if (!mudou) {
+        return false;
+    }
+
+    // Publica o quadro; o núcleo 1 transmite em segundo plano (ver output.c)
+    output_frame_ready();
+    return true;
+}
+
+
+
+// Funções de Ação do Menu: abrem uma tela e retornam na hora
+
+// Temperatura: valor atual e histórico em barras do mínimo ao máximo de cada
+// período. O joystick alterna entre as escalas (últimos 60 minutos ou 24 horas)
+// e, com um sensor externo, entre os sensores.
+#define GRAFICO_X 4
+#define GRAFICO_TOPO 20
+#define GRAFICO_BASE (HEIGHT - 1)
+#define GRAFICO_FAIXA_MIN 100  // Faixa mínima do eixo (centésimos de grau): não amplia o ruído
+
+static uint visao_temperatura; // sensor * 2 + escala
+
+static int grafico_y(int16_t cc, int16_t baixo, int16_t alto) {
+    return GRAFICO_BASE - (cc - baixo) * (GRAFICO_BASE - GRAFICO_TOPO) / (alto - baixo);
+}
+
+static void desenhar_temperatura(void *ctx) {
+    (void)ctx;
+    uint sensor = visao_temperatura / 2;
+    temperature_scale_t escala = visao_temperatura % 2 ? TEMPERATURE_HOUR : TEMPERATURE_MINUTE;
+    uint periodos = escala == TEMPERATURE_HOUR ? TEMPERATURE_HOURS : TEMPERATURE_MINUTES;
+    temperature_aggregate_t historico[TEMPERATURE_MINUTES];
+    uint n = temperature_history(sensor, escala, historico, periodos);
+    char valor[8], linha[32];
+    int16_t cc;
+
+    ssd1306_fill(&ssd, false);
+    if (temperature_current(sensor, &cc)) {
+        temperature_format(cc, valor, sizeof(valor));
+    } else {
+        strcpy(valor, "--.-");
+    }
+    if (temperature_sensor_count() > 1) {
+        snprintf(linha, sizeof(linha), "%s %s C", temperature_sensor_name(sensor), valor);
+    } else {
+        snprintf(linha, sizeof(linha), "Temp. %s C", valor);
+    }
+    ssd1306_draw_string(&ssd, linha, 0, 0);
+    ssd1306_draw_string(&ssd, escala == TEMPERATURE_HOUR ? "24h" : " 1h", WIDTH - 24, 0);
+    if (n == 0) {
+        ssd1306_draw_string(&ssd, "Coletando...", 10, 36);
+        return;
+    }
+
+    int16_t baixo = historico[0].min_cc, alto = historico[0].max_cc;
+    for (uint i = 1; i < n; i++) {
+        if (historico[i].min_cc < baixo) baixo = historico[i].min_cc;
+        if (historico[i].max_cc > alto) alto = historico[i].max_cc;
+    }
+    char texto_baixo[8], texto_alto[8];
+    temperature_format(baixo, texto_baixo, sizeof(texto_baixo));
+    temperature_format(alto, texto_alto, sizeof(texto_alto));
+    snprintf(linha, sizeof(linha), "%s a %s", texto_baixo, texto_alto);
+    ssd1306_draw_string(&ssd, linha, 0, 10);
+    if (alto - baixo < GRAFICO_FAIXA_MIN) {
+        int16_t meio = (int16_t)((baixo + alto) / 2);
+        baixo = meio - GRAFICO_FAIXA_MIN / 2;
+        alto = meio + GRAFICO_FAIXA_MIN / 2;
+    }
+
+    // Uma barra por período, alinhadas à direita (o mais recente é o em andamento)
+    int largura = (WIDTH - GRAFICO_X) / (int)periodos;
+    for (uint i = 0; i < n; i++) {
+        int x = GRAFICO_X + (int)(periodos - n + i) * largura;
+        int topo = grafico_y(historico[i].max_cc, baixo, alto);
+        int base = grafico_y(historico[i].min_cc, baixo, alto);
+        for (int c = 0; c < (largura > 1 ? largura - 1 : 1); c++) {
+            ssd1306_vline(&ssd, x + c, topo, base, true);
+        }
+    }
+}
+
+static bool atualizar_temperatura(void *ctx) {
+    (void)ctx;
+    return true; // Um valor novo por segundo
+}
+
+static bool evento_temperatura(void *ctx, const input_event_t *evento) {
+    (void)ctx;
+    uint visoes = temperature_sensor_count() * 2;
+    if (evento->type == INPUT_DOWN) {
+        visao_temperatura = (visao_temperatura + 1) % visoes;
+    } else if (evento->type == INPUT_UP) {
+        visao_temperatura = (visao_temperatura + visoes - 1) % visoes;
+    } else {
+        return false;
+    }
+    screen_invalidate();
+    return true;
+}
+
+static void fechar_temperatura(void *ctx) {
+    (void)ctx;
+    voltar_menu_principal(); // Como antes: ao sair da temperatura, volta ao menu principal
+}
+
+static const screen_t tela_temperatura = {
+    .name = "temperatura",
+    .draw = desenhar_temperatura,
+    .update = atualizar_temperatura,
+    .event = evento_temperatura,
+    .exit = fechar_temperatura,
+    .refresh_us = ATUALIZACAO_US,
+};
+
+void mostrar_temperatura() {
+    screen_push(&tela_temperatura, NULL);
+}
+
+void mostrar_umidade() {
+    exibir_mensagem("Umidade:", "65%");
+}
+
+void mostrar_posicao() {
+    exibir_mensagem("Latitude: -23.5", "Longitude: -46.6");
+}
+
+void mostrar_mensagens() {
+    exibir_mensagem("Sem mensagens", NULL);
+}
+
+void configurar_sistema() {
+    exibir_mensagem("Config. Sistema", "Ajustes feitos");
+}
+
+// Informações do sistema com o tempo ligado atualizado a cada segundo; fica
+// aberta até o Botão A (ou o timeout do menu)
+static uint32_t segundos_ligado;
+
+static void desenhar_informacoes(void *ctx) {
+    (void)ctx;
+    char linha[24];
+    snprintf(linha, sizeof(linha), "Ligado: %lus", (unsigned long)segundos_ligado);
+    ssd1306_fill(&ssd, false);
+    ssd1306_draw_string(&ssd, "Info. Sistema", 10, 20);
+    ssd1306_draw_string(&ssd, "Versao 1.0", 10, 40);
+    ssd1306_draw_string(&ssd, linha, 10, 54);
+}
+
+static bool atualizar_informacoes(void *ctx) {
+    (void)ctx;
+    uint32_t agora = (uint32_t)(time_us_64() / 1000000);
+    if (agora == segundos_ligado) {
+        return false;
+    }
+    segundos_ligado = agora;
+    return true;
+}
+
+static void abrir_informacoes(void *ctx) {
+    atualizar_informacoes(ctx);
+}
+
+static const screen_t tela_informacoes = {
+    .name = "informacoes",
+    .enter = abrir_informacoes,
+    .draw = desenhar_informacoes,
+    .update = atualizar_informacoes,
+    .refresh_us = ATUALIZACAO_US,
+};
+
+void mostrar_informacoes() {
+    screen_push(&tela_informacoes, NULL);
+}
+
+// Medição de latência entrada -> tela: instante do evento que alterou o menu
+// e número do quadro publicado com essa alteração
+static bool latencia_pendente = false;
+static uint32_t latencia_evento_us;
+static uint32_t latencia_quadro;
+
+// Após desenhar em resposta a um evento, guarda o quadro que o leva ao painel
+static void medir_latencia(uint32_t evento_us) {
+    latencia_evento_us = evento_us;
+    latencia_quadro = output_frame_published();
+    latencia_pendente = true;
+}
+
+// Quando o núcleo 1 informa que o quadro chegou ao painel, registra a latência
+// com o instante do fim do envio (não o instante em que o núcleo 0 percebeu)
+void verificar_latencia() {
+    uint32_t mostrado_us;
+    if (!latencia_pendente || (int32_t)(output_frame_displayed(&mostrado_us) - latencia_quadro) < 0) {
+        return;
+    }
+    latencia_pendente = false;
+    input_latency_record(latencia_evento_us, mostrado_us);
+    TRACE_COMPLETE(TRACE_INPUT_TO_PHOTON, latencia_evento_us, mostrado_us);
+    const input_latency_t *l = input_latency();
+    LOG_I(LOG_INPUT, "Latencia entrada->tela: %lu us (media %lu, max %lu)",
+          (unsigned long)l->last_us, (unsigned long)l->avg_us, (unsigned long)l->max_us);
+}
+
+// Teclado matricial: A/B/#/* equivalem a cima/baixo/selecionar/voltar, também
+// nas telas abertas; os dígitos seguem como INPUT_KEY_PRESS (atalhos do menu)
+static void traduzir_tecla(input_event_t *evento) {
+    switch (evento->key) {
+        case 'A': evento->type = INPUT_UP; break;
+        case 'B': evento->type = INPUT_DOWN; break;
+        case '#': evento->type = INPUT_SELECT; break;
+        case '*': evento->type = INPUT_BACK; break;
+    }
+}
+
+// Atalho numérico: a tecla N seleciona a N-ésima opção do menu atual
+static void atalho_menu(char tecla) {
+    int opcao = tecla - '1';
+    if (opcao < 0 || opcao >= num_opcoes || opcao > 8) {
+        return;
+    }
+    LOG_D(LOG_MENU, "Atalho do teclado - Opcao: %d", opcao);
+    opcao_atual = opcao;
+    opcao_selecionada();
+}
+
+// Navega pelo menu consumindo os eventos de entrada enfileirados pelas interrupções
+void navegar_menu() {
+    input_event_t evento;
+    while (input_poll(&evento)) {
+        sched_postpone(tarefa_timeout, MENU_TIMEOUT_US);
+        // A entrada que acorda o painel apagado não chega ao menu
+        if (power_event(&evento)) {
+            continue;
+        }
+        if (evento.type == INPUT_KEY_PRESS) {
+            traduzir_tecla(&evento);
+        }
+
+        if (evento.type == INPUT_BOOTSEL) {
+            reset_usb_boot(0, 0);
+        }
+        if (evento.type == INPUT_CHORD) {
+            // Combinação A + joystick: imprime o trace (o Botão A não volta ao menu principal)
+            trace_dump();
+            continue;
+        }
+
+        // Com uma tela aberta, ela recebe os eventos (o Botão A a fecha)
+        if (screen_event(&evento)) {
+            continue;
+        }
+
+        switch (evento.type) {
+            case INPUT_DOWN:
+                opcao_atual = (opcao_atual + 1) % num_opcoes;
+                LOG_D(LOG_MENU, "Navegando para Baixo - Opcao: %d", opcao_atual);
+                break;
+            case INPUT_UP:
+                opcao_atual = (opcao_atual - 1 + num_opcoes) % num_opcoes;
+                LOG_D(LOG_MENU, "Navegando para Cima - Opcao: %d", opcao_atual);
+                break;
+            case INPUT_SELECT:
+                LOG_D(LOG_MENU, "Botao Joystick Pressionado - Opcao: %d", opcao_atual);
+                TRACE_BEGIN(TRACE_SELECT);
+                opcao_selecionada();
+                TRACE_END(TRACE_SELECT);
+                break;
+            case INPUT_BACK:
+                LOG_D(LOG_MENU, "Botao A Pressionado - Voltando ao Menu Principal");
+                voltar_menu_principal();
+                break;
+            case INPUT_LONG_PRESS:
+                // Segurar o botão do joystick volta um nível
+                if (evento.gpio == JOYSTICK_PB) {
+                    pop_menu();
+                }
+                break;
+            case INPUT_KEY_PRESS:
+                atalho_menu((char)evento.key);
+                break;
+        }
+
+        if (mostrar_menu()) {
+            medir_latencia(evento.timestamp_us);
+        }
+    }
+}
+
+// Retorna ao Menu Principal
+void voltar_menu_principal() {
+    abrir_menu(MENU_RAIZ, 0);
+    mostrar_menu();
+}
+
+// Função de seleção de opção do menu
+void opcao_selecionada() {
+    const ItemMenu *item = item_menu(menu_atual, opcao_atual);
+    LOG_I(LOG_MENU, "Opcao Selecionada: %s", item->titulo);
+
+    switch (item->tipo) {
+        case ITEM_VOLTAR:
+            pop_menu();
+            mostrar_menu();
+            break;
+        case ITEM_ACAO:
+            LOG_D(LOG_MENU, "Executando acao para: %s", item->titulo);
+            invalidar_menu(); // A ação desenha a própria tela
+            item->acao();
+            break;
+        case ITEM_SUBMENU:
+            push_menu(menu_itens[menu_atual].primeiro_filho + opcao_atual);
+            mostrar_menu();
+            break;
+    }
+}
+
+// Exibe o submenu menu com a opção opcao selecionada
+static void abrir_menu(uint16_t menu, int opcao) {
+    menu_atual = menu;
+    num_opcoes = menu_itens[menu].num_filhos;
+    opcao_atual = opcao;
+}
+
+// Entra num submenu; o caminho de volta é o índice do pai, sem pilha de histórico
+static void push_menu(uint16_t submenu) {
+    abrir_menu(submenu, 0);
+}
+
+// Volta ao menu anterior, com o cursor no submenu de onde se saiu
+static void pop_menu() {
+    if (menu_atual != MENU_RAIZ) {
+        abrir_menu(menu_itens[menu_atual].pai, menu_itens[menu_atual].posicao);
+    }
+}
+
+// Sem interação por MENU_TIMEOUT_US: fecha as telas abertas e volta ao menu principal
+static void timeout_menu(void *arg) {
+    (void)arg;
+    screen_close_all();
+    voltar_menu_principal();
+}
+
+// Abre o menu principal, liga as telas de ação à lista e agenda o timeout
+void iniciar_menu() {
+    abrir_menu(MENU_RAIZ, 0);
+    screen_init(invalidar_menu);
+    tarefa_timeout = sched_after(MENU_TIMEOUT_US, MENU_TIMEOUT_US, timeout_menu, NULL);
+}
@@ -0,0 +1,49 @@
+#ifndef MENU_H
+#define MENU_H
+
+// Árvore do menu em tabelas constantes (flash), geradas de menu.txt por
+// tools/gen_menu.py no menu_tables.h. Os itens ficam numa só tabela em ordem de
+// largura: os filhos de um submenu são contíguos, então o item n de um submenu é
+// menu_itens[primeiro_filho + n] e voltar é seguir o índice do pai. Nenhum
+// ponteiro de navegação em RAM e nenhuma comparação de strings.
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+typedef enum {
+    ITEM_SUBMENU,
+    ITEM_ACAO,
+    ITEM_VOLTAR
+} TipoItem;
+
+typedef struct {
+    const char *titulo;
+    void (*acao)(void);         // ITEM_ACAO
+    uint16_t pai;               // Submenu que contém o item (a raiz aponta para si mesma)
+    uint16_t primeiro_filho;    // ITEM_SUBMENU: índice do primeiro item do submenu
+    uint16_t num_filhos;
+    uint16_t posicao;           // Posição do item entre os irmãos
+    uint8_t tipo;               // TipoItem
+    uint8_t largura;            // Largura do título em pixels
+} ItemMenu;
+
+#define MENU_RAIZ 0             // Menu principal (item sem título)
+
+// Navegação e telas do menu (menu.c), usadas pelo main e pelos benchmarks
+extern ssd1306_t ssd;           // OLED: o menu e as telas de ação desenham aqui
+extern int opcao_atual;         // Opção selecionada no submenu exibido
+extern uint16_t menu_atual;     // Submenu exibido (índice em menu_itens)
+extern int num_opcoes;          // Opções do submenu exibido
+
+void iniciar_oled();
+void iniciar_menu();            // Depois de output_init: menu principal, telas e timeout
+void animacao_inicial();
+bool mostrar_menu();            // true se algo foi redesenhado (e o quadro publicado)
+void invalidar_menu();
+void navegar_menu();            // Consome os eventos de entrada enfileirados
+void verificar_latencia();
+void voltar_menu_principal();
+void opcao_selecionada();
+void exibir_mensagem(const char *linha1, const char *linha2);
+
+#endif // MENU_H
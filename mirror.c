@@ -0,0 +1,206 @@
+#include <string.h>
+#include "mirror.h"
+#include "output.h"
+#include "log.h"
+#include "pico/stdio_usb.h"
+
+#if MIRROR_HEADER_SIZE + WIDTH > LOG_FRAME_MAX
+#error "Pacote do espelho maior que LOG_FRAME_MAX"
+#endif
+
+static uint8_t shadow[WIDTH * SSD1306_MAX_PAGES];   // Quadro que o visualizador tem
+static uint8_t packet[MIRROR_HEADER_SIZE + WIDTH];
+static uint8_t scratch[WIDTH];
+
+static bool active;
+static bool reset_pending;      // Próximo pacote leva MIRROR_FLAG_RESET
+static bool dirty;              // Há mudanças ainda não enviadas
+static uint32_t frame_seen;     // Último quadro publicado já comparado
+static uint8_t start_line;      // Linha inicial que o visualizador tem
+static uint16_t seq;
+static uint32_t unacked;
+static uint32_t last_ack_us;
+static mirror_stats_t stats;
+
+void mirror_start(void) {
+    memset(shadow, 0, sizeof(shadow));
+    start_line = 0;
+    active = true;
+    reset_pending = true;
+    dirty = true;
+    unacked = 0;
+    last_ack_us = time_us_32();
+    stats = (mirror_stats_t){0};
+    LOG_I(LOG_OLED, "Espelho ligado");
+}
+
+void mirror_stop(void) {
+    if (!active)
+        return;
+    active = false;
+    LOG_I(LOG_OLED, "Espelho desligado: %lu pacotes, %lu bytes (%lu sem codificacao), %lu esperas",
+          (unsigned long)stats.packets, (unsigned long)stats.bytes, (unsigned long)stats.raw_bytes,
+          (unsigned long)stats.stalls);
+}
+
+void mirror_ack(void) {
+    if (unacked)
+        unacked--;
+    last_ack_us = time_us_32();
+}
+
+bool mirror_active(void) {
+    return active;
+}
+
+// PackBits de src (ou src XOR ref): n de controle 0..127 = n + 1 bytes literais,
+// 129..255 = o byte seguinte repetido 257 - n vezes. Retorna o tamanho, ou 0 se
+// passaria de max.
+static uint packbits(const uint8_t *src, const uint8_t *ref, uint n, uint8_t *out, uint max) {
+#define AT(i) (uint8_t)(src[i] ^ (ref ? ref[i] : 0))
+    uint len = 0;
+    uint i = 0;
+    while (i < n) {
+        uint8_t b = AT(i);
+        uint run = 1;
+        while (i + run < n && run < 128 && AT(i + run) == b)
+            run++;
+        if (run >= 2) {
+            if (len + 2 > max)
+                return 0;
+            out[len++] = (uint8_t)(257 - run);
+            out[len++] = b;
+            i += run;
+            continue;
+        }
+        // Literais até o início de uma repetição
+        uint start = i;
+        while (i < n && i - start < 128 && !(i + 1 < n && AT(i) == AT(i + 1)))
+            i++;
+        uint count = i - start;
+        if (len + 1 + count > max)
+            return 0;
+        out[len++] = (uint8_t)(count - 1);
+        for (uint k = start; k < i; k++)
+            out[len++] = AT(k);
+    }
+    return len;
+#undef AT
+}
+
+// false se o pacote não coube no FIFO de TX da USB (nada muda; tenta de novo
+// na próxima chamada)
+static bool send_span(const uint8_t *row, uint page, uint x0, uint n, bool end) {
+    uint8_t *old = &shadow[(page % SSD1306_MAX_PAGES) * WIDTH + x0 % WIDTH];
+    uint8_t *data = &packet[MIRROR_HEADER_SIZE];
+    mirror_encoding_t encoding = MIRROR_RAW;
+    uint len = n;
+
+    // Vale a menor codificação; a cópia crua é o limite
+    uint xor_len = n ? packbits(&row[x0], old, n, data, n - 1) : 0;
+    if (xor_len) {
+        encoding = MIRROR_XOR_RLE;
+        len = xor_len;
+    }
+    uint rle_len = n ? packbits(&row[x0], NULL, n, scratch, len - 1) : 0;
+    if (rle_len) {
+        encoding = MIRROR_RLE;
+        len = rle_len;
+        memcpy(data, scratch, len);
+    } else if (encoding == MIRROR_RAW) {
+        memcpy(data, &row[x0], n);
+    }
+
+    packet[0] = (uint8_t)seq;
+    packet[1] = (uint8_t)(seq >> 8);
+    packet[2] = LOG_MODULE_FRAME;
+    packet[3] = MIRROR_FRAME_TYPE;
+    packet[4] = (uint8_t)(encoding | (reset_pending ? MIRROR_FLAG_RESET : 0) | (end ? MIRROR_FLAG_END : 0));
+    packet[5] = (uint8_t)page;
+    packet[6] = (uint8_t)x0;
+    packet[7] = (uint8_t)n;
+    if (!log_write_frame(packet, MIRROR_HEADER_SIZE + len)) {
+        stats.stalls++;
+        return false;
+    }
+
+    if (page == MIRROR_PAGE_START_LINE)
+        start_line = (uint8_t)x0;
+    else
+        memcpy(old, &row[x0], n);
+    reset_pending = false;
+    seq++;
+    unacked++;
+    stats.packets++;
+    stats.bytes += MIRROR_HEADER_SIZE + len;
+    stats.raw_bytes += n;
+    return true;
+}
+
+bool mirror_poll(const ssd1306_t *ssd) {
+    if (!active || !stdio_usb_connected())
+        return false;
+    uint32_t frame = output_frame_published();
+    if (frame != frame_seen) {
+        frame_seen = frame;
+        dirty = true;
+    }
+    if (!dirty)
+        return false;
+    if (unacked >= MIRROR_WINDOW) {
+        // Visualizador atrasado: as mudanças se acumulam até a próxima confirmação
+        stats.stalls++;
+        if (time_us_32() - last_ack_us > MIRROR_ACK_TIMEOUT_US) {
+            LOG_W(LOG_OLED, "Espelho sem confirmacoes");
+            mirror_stop();
+        }
+        return false;
+    }
+
+    // Faixa alterada de cada página em relação ao que o visualizador tem
+    uint8_t x0[SSD1306_MAX_PAGES], x1[SSD1306_MAX_PAGES];
+    int last = -1;
+    for (uint p = 0; p < ssd->pages; p++) {
+        const uint8_t *row = &ssd->ram_buffer[1 + p * ssd->width];
+        const uint8_t *old = &shadow[p * WIDTH];
+        x0[p] = 1;
+        x1[p] = 0;
+        if (!memcmp(row, old, ssd->width))
+            continue;
+        uint a = 0, b = ssd->width - 1;
+        while (row[a] == old[a])
+            a++;
+        while (row[b] == old[b])
+            b--;
+        x0[p] = (uint8_t)a;
+        x1[p] = (uint8_t)b;
+        last = (int)p;
+    }
+
+    // A linha inicial muda depois dos dados, como no painel
+    bool line_changed = ssd->start_line != start_line;
+    uint sent = 0;
+    for (int p = 0; p <= last; p++) {
+        if (x0[p] > x1[p])
+            continue;
+        if (sent == MIRROR_PACKETS_PER_POLL || unacked >= MIRROR_WINDOW)
+            return unacked < MIRROR_WINDOW;
+        if (!send_span(&ssd->ram_buffer[1 + p * ssd->width], (uint)p, x0[p], x1[p] - x0[p] + 1u,
+                       p == last && !line_changed))
+            return false;
+        sent++;
+    }
+    if (line_changed || (last < 0 && reset_pending)) {
+        // Sem faixas alteradas o pacote ainda leva a linha inicial (ou o zero inicial do quadro)
+        if (sent == MIRROR_PACKETS_PER_POLL || unacked >= MIRROR_WINDOW)
+            return unacked < MIRROR_WINDOW;
+        if (!send_span(shadow, MIRROR_PAGE_START_LINE, ssd->start_line, 0, true))
+            return false;
+    }
+    dirty = false;
+    return false;
+}
+
+const mirror_stats_t *mirror_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,69 @@
+#ifndef MIRROR_H
+#define MIRROR_H
+
+// Espelho do OLED pela serial USB: com o espelho ligado, o loop principal
+// compara o quadro publicado com uma cópia do que o visualizador já tem
+// (tools/mirror_view.py) e envia só a faixa de colunas alterada de cada página.
+// Nada muda no envio ao painel (núcleo 1). Cada pacote sai como um quadro COBS no
+// mesmo fluxo do log (log_write_frame), com LOG_MODULE_FRAME no cabeçalho:
+//
+//   [0..1] número do pacote   [2] LOG_MODULE_FRAME   [3] MIRROR_FRAME_TYPE
+//   [4] codificação | MIRROR_FLAG_*   [5] página   [6] primeira coluna   [7] colunas
+//   [8..]  dados da faixa
+//
+// Com a página MIRROR_PAGE_START_LINE o pacote não tem dados e a coluna é a
+// nova linha inicial do painel (rolagem da lista, ver list_view.h); ele vem
+// depois das faixas do mesmo quadro.
+//
+// Codificações: bytes crus, PackBits dos bytes ou PackBits do XOR com o quadro
+// anterior; vale a menor. O visualizador confirma cada pacote com
+// MIRROR_CMD_ACK e no máximo MIRROR_WINDOW pacotes ficam sem confirmação:
+// com o visualizador atrasado, os quadros intermediários se fundem na próxima
+// diferença em vez de encher o buffer da USB e bloquear o firmware. Um pacote
+// que não cabe no FIFO de TX do CDC espera a chamada seguinte (log_write_frame).
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+#define MIRROR_HEADER_SIZE 8
+#define MIRROR_FRAME_TYPE 0x01
+#define MIRROR_WINDOW 8                 // Pacotes sem confirmação (um quadro inteiro)
+#define MIRROR_PACKETS_PER_POLL 4       // Limita o tempo de cada chamada no loop
+#define MIRROR_ACK_TIMEOUT_US 2000000   // Sem confirmações por esse tempo, o espelho desliga
+
+// Comandos recebidos pela serial USB
+#define MIRROR_CMD_START 'm'            // Liga (ou reinicia) com o quadro inteiro
+#define MIRROR_CMD_STOP 'M'
+#define MIRROR_CMD_ACK 'k'              // Um pacote processado pelo visualizador
+
+typedef enum {
+    MIRROR_RAW,
+    MIRROR_RLE,
+    MIRROR_XOR_RLE,
+} mirror_encoding_t;
+
+#define MIRROR_ENCODING_MASK 0x03
+#define MIRROR_FLAG_RESET 0x10          // Visualizador zera o quadro antes de aplicar
+#define MIRROR_FLAG_END 0x20            // Último pacote das mudanças vistas: redesenhar
+#define MIRROR_PAGE_START_LINE 0x80
+
+typedef struct {
+    uint32_t packets;
+    uint32_t bytes;         // Cabeçalhos e dados, antes do COBS
+    uint32_t raw_bytes;     // Bytes das faixas sem codificação
+    uint32_t stalls;        // Chamadas com a janela ou o FIFO de TX da USB cheios
+} mirror_stats_t;
+
+void mirror_start(void);
+void mirror_stop(void);
+void mirror_ack(void);
+bool mirror_active(void);
+
+// Loop principal (núcleo 0), depois de publicar o quadro: envia até
+// MIRROR_PACKETS_PER_POLL pacotes. Retorna true se ainda há o que enviar agora.
+bool mirror_poll(const ssd1306_t *ssd);
+
+const mirror_stats_t *mirror_stats(void);
+
+#endif // MIRROR_H
@@ -0,0 +1,265 @@
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "output.h"
+#include "led_matrix.h"
+#include "trace.h"
+#include "log.h"
+#include "pico/multicore.h"
+#include "pico/sync.h"
+#include "hardware/sync.h"
+
+// Protege o que os dois núcleos tocam: o front buffer e as faixas pendentes do
+// OLED (ssd1306_swap no núcleo 0, ssd1306_flush_start/poll no núcleo 1) e a cópia
+// das cores dos LEDs. As seções são curtas (cópias de memória, sem esperar o barramento).
+static critical_section_t lock;
+static ssd1306_t *oled;
+static led_word_t leds_published[LED_COUNT];
+
+// Numeração dos quadros: o núcleo 0 incrementa published a cada publicação; o núcleo 1
+// registra em displayed o último quadro que chegou ao painel e quando isso ocorreu
+static uint32_t frames_published;       // Escrito sob a seção crítica (núcleo 0)
+static uint32_t frame_in_flight;        // Núcleo 1: quadro mais recente contido no envio em curso
+static _Atomic uint32_t frames_displayed;
+static _Atomic uint32_t displayed_at_us;
+
+// Profundidade da fila de pedidos (o FIFO do SIO não informa a ocupação)
+static _Atomic uint32_t commands_pushed;   // Escrito pelo núcleo 0
+static _Atomic uint32_t commands_popped;   // Escrito pelo núcleo 1
+
+// Estado pedido para o painel (núcleo 0) e último pedido aplicado (núcleo 1)
+static _Atomic uint32_t panel_requested;   // Número do pedido << 16 | ligado << 8 | contraste
+static _Atomic uint32_t panel_applied;
+static _Atomic uint32_t panel_applied_us;
+
+static output_stats_t stats;
+static _Atomic uint32_t idle_us[2];
+static uint32_t window_start_us;
+static uint32_t commands_at_window;
+
+static void push_command(output_cmd_t cmd) {
+    uint32_t pushed = atomic_load_explicit(&commands_pushed, memory_order_relaxed) + 1;
+    atomic_store_explicit(&commands_pushed, pushed, memory_order_release);
+    uint32_t depth = pushed - atomic_load_explicit(&commands_popped, memory_order_acquire);
+    if (depth > stats.queue_max)
+        stats.queue_max = depth;
+    multicore_fifo_push_blocking(cmd); // Bloqueia só com o FIFO cheio (8 pedidos); acorda o núcleo 1 (SEV)
+}
+
+static void mark_displayed(uint32_t frame) {
+    atomic_store_explicit(&displayed_at_us, time_us_32(), memory_order_relaxed);
+    atomic_store_explicit(&frames_displayed, frame, memory_order_release);
+}
+
+// Chamado por ssd1306_flush_poll (núcleo 1, dentro da seção crítica) ao fim de cada envio
+static void frame_sent(ssd1306_t *ssd, void *ctx) {
+    (void)ctx;
+    TRACE_COMPLETE(TRACE_FLUSH, (uint32_t)ssd->flush_start_us, time_us_32());
+    mark_displayed(frame_in_flight);
+}
+
+// Depois de qualquer passo do envio: associa um quadro recém-iniciado aos quadros
+// publicados até aqui e, se não resta nada a enviar, todos já estão no painel
+static void track_frames(uint32_t started_before) {
+    if (oled->frames_started != started_before)
+        frame_in_flight = frames_published;
+    else if (!oled->flush_busy && !oled->frame_queued)
+        mark_displayed(frames_published);
+}
+
+// Fim de um quadro dos LEDs (alarme no núcleo 0): da DMA à trava na fita
+static void leds_sent(uint32_t started_us, void *ctx) {
+    (void)ctx;
+    (void)started_us; // Sem uso com o trace desligado
+    TRACE_COMPLETE(TRACE_LEDS_WIRE, started_us, time_us_32());
+}
+
+// Núcleo 1, sem envio de quadro em curso: aplica o estado pedido. Com o painel
+// desligado os LEDs recebem um quadro apagado e os pedidos de cores só são
+// guardados; ao religar, o último quadro publicado volta à matriz.
+static void apply_panel(uint32_t request, bool *leds_on, led_word_t *leds_frame) {
+    static uint32_t current = 0xFFFFu;   // Desconhecido: aplica tudo no primeiro pedido
+    uint32_t state = request & 0xFFFFu;
+    bool on = state >> 8;
+    if ((state ^ current) & 0xFFu)
+        ssd1306_set_contrast(oled, (uint8_t)state);
+    if ((state ^ current) & 0xFF00u)
+        ssd1306_set_display_on(oled, on);
+    current = state;
+
+    if (on != *leds_on) {
+        *leds_on = on;
+        if (on) {
+            critical_section_enter_blocking(&lock);
+            memcpy(leds_frame, leds_published, LED_COUNT * sizeof(led_word_t));
+            critical_section_exit(&lock);
+        } else {
+            memset(leds_frame, 0, LED_COUNT * sizeof(led_word_t));
+        }
+        led_matrix_send(leds_frame);
+    }
+    atomic_store_explicit(&panel_applied_us, time_us_32(), memory_order_relaxed);
+    atomic_store_explicit(&panel_applied, request >> 16, memory_order_release);
+}
+
+static void core1_main(void) {
+    static led_word_t leds_frame[LED_COUNT];
+    bool leds_on = true;
+    bool panel_pending = false;
+    led_matrix_init();
+    led_matrix_set_done_callback(leds_sent, NULL);
+    led_matrix_write();
+
+    while (true) {
+        uint32_t cmd;
+        while (multicore_fifo_pop_timeout_us(0, &cmd)) {
+            atomic_store_explicit(&commands_popped,
+                                  atomic_load_explicit(&commands_popped, memory_order_relaxed) + 1,
+                                  memory_order_release);
+            switch (cmd) {
+                case OUTPUT_CMD_FRAME: {
+                    critical_section_enter_blocking(&lock);
+                    uint32_t before = oled->frames_started;
+                    TRACE_BEGIN(TRACE_FLUSH_START);
+                    ssd1306_flush_start(oled);
+                    TRACE_END(TRACE_FLUSH_START);
+                    track_frames(before);
+                    critical_section_exit(&lock);
+                    break;
+                }
+                case OUTPUT_CMD_LEDS:
+                    if (!leds_on)
+                        break;
+                    critical_section_enter_blocking(&lock);
+                    memcpy(leds_frame, leds_published, sizeof(leds_frame));
+                    critical_section_exit(&lock);
+                    TRACE_BEGIN(TRACE_LEDS);
+                    led_matrix_send(leds_frame); // Só copia, limita a corrente e dispara a DMA; a transmissão segue sozinha
+                    TRACE_END(TRACE_LEDS);
+                    break;
+                case OUTPUT_CMD_PANEL:
+                    panel_pending = true;
+                    break;
+            }
+        }
+
+        critical_section_enter_blocking(&lock);
+        uint32_t before = oled->frames_started;
+        bool busy = ssd1306_flush_poll(oled);
+        track_frames(before);
+        critical_section_exit(&lock);
+
+        // Os comandos do painel usam o barramento: só entre envios de quadro. Fora
+        // da seção crítica, pois o núcleo 0 não toca na fila de comandos do OLED.
+        if (panel_pending && !busy) {
+            panel_pending = false;
+            apply_panel(atomic_load_explicit(&panel_requested, memory_order_acquire), &leds_on, leds_frame);
+        }
+
+        // Dorme até um novo pedido (o push faz SEV) ou, com envio em curso, até a próxima verificação
+        if (multicore_fifo_rvalid())
+            continue;
+        uint32_t sleep_start = time_us_32();
+        if (busy)
+            best_effort_wfe_or_timeout(make_timeout_time_us(OUTPUT_POLL_US));
+        else
+            __wfe();
+        output_record_idle(time_us_32() - sleep_start);
+    }
+}
+
+// Inicia o núcleo 1 como dono do OLED já configurado e da matriz de LEDs
+void output_init(ssd1306_t *ssd) {
+    oled = ssd;
+    critical_section_init(&lock);
+    ssd1306_set_flush_callback(oled, frame_sent, NULL);
+    window_start_us = time_us_32();
+    multicore_launch_core1(core1_main);
+}
+
+// Núcleo 0: publica o ram_buffer (cópia das regiões alteradas para o front buffer) e
+// pede a transmissão. Pode-se voltar a desenhar imediatamente. Retorna o número do quadro.
+uint32_t output_frame_ready(void) {
+    TRACE_BEGIN(TRACE_FRAME_READY);
+    critical_section_enter_blocking(&lock);
+    ssd1306_swap(oled);
+    uint32_t frame = ++frames_published;
+    critical_section_exit(&lock);
+    push_command(OUTPUT_CMD_FRAME);
+    TRACE_END(TRACE_FRAME_READY);
+    return frame;
+}
+
+uint32_t output_frame_published(void) {
+    return frames_published;
+}
+
+// Último quadro que chegou ao painel e o instante (time_us_32) em que o envio terminou
+uint32_t output_frame_displayed(uint32_t *displayed_us) {
+    uint32_t frame = atomic_load_explicit(&frames_displayed, memory_order_acquire);
+    if (displayed_us)
+        *displayed_us = atomic_load_explicit(&displayed_at_us, memory_order_relaxed);
+    return frame;
+}
+
+// Núcleo 0: publica as cores definidas com led_matrix_set_pixel e pede a escrita
+void output_leds_update(void) {
+    critical_section_enter_blocking(&lock);
+    led_matrix_copy(leds_published);
+    critical_section_exit(&lock);
+    push_command(OUTPUT_CMD_LEDS);
+}
+
+// Núcleo 0: só o estado mais recente importa; pedidos seguidos antes de o
+// núcleo 1 aplicar o anterior se fundem
+uint32_t output_panel(bool on, uint8_t contrast) {
+    static uint32_t requests;
+    uint32_t request = ++requests & 0xFFFFu;
+    atomic_store_explicit(&panel_requested, request << 16 | (uint32_t)on << 8 | contrast, memory_order_release);
+    push_command(OUTPUT_CMD_PANEL);
+    return request;
+}
+
+uint32_t output_panel_applied(uint32_t *applied_us) {
+    uint32_t request = atomic_load_explicit(&panel_applied, memory_order_acquire);
+    if (applied_us)
+        *applied_us = atomic_load_explicit(&panel_applied_us, memory_order_relaxed);
+    return request;
+}
+
+// Acumula o tempo que o núcleo atual passou dormindo
+void output_record_idle(uint32_t us) {
+    atomic_fetch_add_explicit(&idle_us[get_core_num()], us, memory_order_relaxed);
+}
+
+const output_stats_t *output_stats(void) {
+    stats.window_us = time_us_32() - window_start_us;
+    for (uint core = 0; core < 2; core++)
+        stats.idle_us[core] = atomic_load_explicit(&idle_us[core], memory_order_relaxed);
+    uint32_t popped = atomic_load_explicit(&commands_popped, memory_order_acquire);
+    stats.queue_depth = atomic_load_explicit(&commands_pushed, memory_order_relaxed) - popped;
+    stats.commands = popped - commands_at_window;
+    return &stats;
+}
+
+// Percentual do tempo acordado na janela
+static unsigned long busy_percent(uint32_t idle, uint32_t window) {
+    uint32_t idle_pct = (uint32_t)(((uint64_t)idle * 100) / window);
+    return idle_pct < 100 ? 100 - idle_pct : 0;
+}
+
+// Núcleo 0: registra a utilização de cada núcleo e da fila a cada OUTPUT_REPORT_US e reinicia a janela
+void output_report(void) {
+    if (time_us_32() - window_start_us < OUTPUT_REPORT_US)
+        return;
+    const output_stats_t *s = output_stats();
+    LOG_I(LOG_OUTPUT, "Uso: nucleo0 %lu%%, nucleo1 %lu%%, fila %lu (max %lu), %lu pedidos",
+          busy_percent(s->idle_us[0], s->window_us), busy_percent(s->idle_us[1], s->window_us),
+          (unsigned long)s->queue_depth, (unsigned long)s->queue_max, (unsigned long)s->commands);
+
+    window_start_us = time_us_32();
+    commands_at_window += s->commands;
+    stats.queue_max = s->queue_depth;
+    for (uint core = 0; core < 2; core++)
+        atomic_fetch_sub_explicit(&idle_us[core], s->idle_us[core], memory_order_relaxed);
+}
@@ -0,0 +1,47 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+// Pipeline de saída em dois núcleos: o núcleo 0 trata entrada e lógica do menu e
+// desenha no ram_buffer do OLED; o núcleo 1 é dono da transmissão (ssd1306_flush_*,
+// DMA do I2C) e da máquina de estados PIO da matriz de LEDs. Os pedidos vão pelo
+// FIFO entre núcleos; os dados compartilhados (cópia do quadro para o front buffer
+// e das cores dos LEDs) são trocados sob uma seção crítica curta.
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+#define OUTPUT_POLL_US 100          // Intervalo de verificação do envio em curso no núcleo 1
+#define OUTPUT_REPORT_US 5000000    // Período do relatório de utilização (5 s)
+
+typedef enum {
+    OUTPUT_CMD_FRAME = 1,   // Quadro publicado no front buffer: transmitir ao OLED
+    OUTPUT_CMD_LEDS,        // Cores dos LEDs copiadas: escrever na matriz
+    OUTPUT_CMD_PANEL,       // Novo estado do painel (ligado, contraste) e dos LEDs
+} output_cmd_t;
+
+typedef struct {
+    uint32_t window_us;     // Duração da janela de medição
+    uint32_t idle_us[2];    // Tempo dormindo (WFI/WFE) de cada núcleo na janela
+    uint32_t queue_depth;   // Pedidos publicados e ainda não consumidos pelo núcleo 1
+    uint32_t queue_max;     // Maior profundidade observada na janela
+    uint32_t commands;      // Pedidos consumidos na janela
+} output_stats_t;
+
+void output_init(ssd1306_t *ssd);
+
+uint32_t output_frame_ready(void);
+uint32_t output_frame_published(void);
+uint32_t output_frame_displayed(uint32_t *displayed_us);
+void output_leds_update(void);
+
+// Liga/desliga o OLED (a RAM do painel é mantida) e apaga/restaura a matriz de
+// LEDs; o contraste vale com o painel ligado. Retorna o número do pedido, que
+// output_panel_applied informa quando o núcleo 1 o tiver aplicado.
+uint32_t output_panel(bool on, uint8_t contrast);
+uint32_t output_panel_applied(uint32_t *applied_us);
+
+void output_record_idle(uint32_t idle_us);
+const output_stats_t *output_stats(void);
+void output_report(void);
+
+#endif // OUTPUT_H
@@ -0,0 +1,165 @@
+#include "power.h"
+#include "output.h"
+#include "sched.h"
+#include "led_matrix.h"
+#include "log.h"
+
+static const char *const state_names[POWER_STATE_COUNT] = {"ativo", "reduzido", "desligado", "sono"};
+
+// Tempo sem entrada para entrar em cada estado
+static const uint32_t state_after_us[POWER_STATE_COUNT] = {0, POWER_DIM_US, POWER_OFF_US, POWER_SLEEP_US};
+
+static power_state_t state;
+static uint32_t entered_us;
+static int step_task = SCHED_INVALID;
+static power_stats_t stats;
+static uint32_t leds_on_ma = LED_COUNT * LED_IDLE_MA; // Última estimativa da matriz acesa
+
+// Despertar em medição e descarte do pressionamento que acordou
+static bool wake_pending;
+static uint32_t wake_event_us;
+static uint32_t wake_request;
+static bool guarding;
+static uint32_t guard_until_us;
+
+static void account(uint32_t now) {
+    stats.states[state].time_us += now - entered_us;
+    entered_us = now;
+}
+
+static void step(void *arg);
+
+// Aplica o estado e agenda o seguinte. Retorna o pedido enviado ao painel.
+static uint32_t enter(power_state_t next) {
+    power_state_t prev = state;
+    account(time_us_32());
+    state = next;
+    stats.states[next].entries++;
+
+    uint32_t request = 0;
+    if (prev == POWER_SLEEP)
+        input_sleep(false);
+    if (next != POWER_SLEEP) // No sono o painel já está desligado
+        request = output_panel(next < POWER_OFF, next == POWER_DIM ? POWER_CONTRAST_DIM : POWER_CONTRAST_ACTIVE);
+    else
+        input_sleep(true);
+
+    sched_cancel(step_task);
+    step_task = next + 1 < POWER_STATE_COUNT
+        ? sched_after(state_after_us[next + 1] - state_after_us[next], 0, step, NULL)
+        : SCHED_INVALID;
+    LOG_D(LOG_SYS, "Energia: %s", state_names[next]);
+    return request;
+}
+
+static void step(void *arg) {
+    (void)arg;
+    step_task = SCHED_INVALID;
+    if (state + 1 < POWER_STATE_COUNT)
+        enter(state + 1);
+}
+
+static bool is_press(uint8_t type) {
+    return type != INPUT_UP && type != INPUT_DOWN;
+}
+
+bool power_event(const input_event_t *event) {
+    if (state == POWER_ACTIVE) {
+        sched_postpone(step_task, POWER_DIM_US);
+        // Repetições do pressionamento que acordou (ou a sua confirmação pelo debounce)
+        return event->type == INPUT_WAKE || (guarding && is_press(event->type));
+    }
+
+    bool was_off = state >= POWER_OFF;
+    uint32_t request = enter(POWER_ACTIVE);
+    if (!was_off)
+        return event->type == INPUT_WAKE; // Do contraste reduzido o evento segue para o menu
+
+    wake_pending = true;
+    wake_event_us = event->timestamp_us;
+    wake_request = request;
+    guarding = true;
+    guard_until_us = time_us_32() + POWER_WAKE_GUARD_US;
+    return true;
+}
+
+void power_tick(void) {
+    uint32_t now = time_us_32();
+    // O evento do botão que acordou sai ao soltá-lo: a guarda só acaba depois de consumido
+    if (guarding && (int32_t)(now - guard_until_us) >= 0 && !input_any_down() && !input_pending())
+        guarding = false;
+
+    uint32_t applied_us;
+    if (!wake_pending || ((output_panel_applied(&applied_us) - wake_request) & 0x8000u))
+        return;
+    wake_pending = false;
+    uint32_t elapsed = applied_us - wake_event_us;
+    stats.wake_last_us = elapsed;
+    if (elapsed > stats.wake_max_us)
+        stats.wake_max_us = elapsed;
+    stats.wakes++;
+    if (elapsed > POWER_WAKE_TARGET_US) {
+        stats.wakes_late++;
+        LOG_W(LOG_SYS, "Despertar em %lu us (alvo %lu us)", (unsigned long)elapsed, (unsigned long)POWER_WAKE_TARGET_US);
+    } else {
+        LOG_D(LOG_SYS, "Despertar em %lu us", (unsigned long)elapsed);
+    }
+}
+
+void power_record_idle(uint32_t idle_us) {
+    stats.states[state].idle_us += idle_us;
+}
+
+power_state_t power_state(void) {
+    return state;
+}
+
+const power_stats_t *power_stats(void) {
+    account(time_us_32());
+    return &stats;
+}
+
+// Corrente média estimada de um estado com o núcleo 0 ocupado busy_pct% do tempo
+static uint32_t estimate_ma(power_state_t s, uint32_t busy_pct) {
+    uint32_t ma = POWER_CPU_WFI_MA + (POWER_CPU_RUN_MA - POWER_CPU_WFI_MA) * busy_pct / 100;
+    if (s == POWER_ACTIVE)
+        ma += POWER_OLED_MA;
+    else if (s == POWER_DIM)
+        ma += POWER_OLED_DIM_MA;
+    return ma + (s < POWER_OFF ? leds_on_ma : LED_COUNT * LED_IDLE_MA);
+}
+
+// Tempo, ocupação do núcleo 0 e corrente estimada de cada estado desde a partida
+static void report(void *arg) {
+    (void)arg;
+    if (state < POWER_OFF) {
+        led_matrix_power_t leds;
+        led_matrix_power(&leds);
+        leds_on_ma = leds.estimated_ma;
+    }
+    const power_stats_t *s = power_stats();
+    uint64_t total = 0, charge = 0;
+    for (uint i = 0; i < POWER_STATE_COUNT; i++)
+        total += s->states[i].time_us;
+    if (total == 0)
+        return;
+    for (uint i = 0; i < POWER_STATE_COUNT; i++) {
+        const power_state_stats_t *st = &s->states[i];
+        if (st->time_us == 0)
+            continue;
+        uint32_t busy = st->idle_us < st->time_us ? (uint32_t)((st->time_us - st->idle_us) * 100 / st->time_us) : 0;
+        uint32_t ma = estimate_ma((power_state_t)i, busy);
+        charge += (uint64_t)ma * st->time_us;
+        LOG_I(LOG_SYS, "Energia %s: %lu%% do tempo, nucleo0 %lu%%, ~%lu mA", state_names[i],
+              (unsigned long)(st->time_us * 100 / total), (unsigned long)busy, (unsigned long)ma);
+    }
+    LOG_I(LOG_SYS, "Energia: media ~%lu mA; %lu despertares, ultimo %lu us, max %lu us, %lu acima do alvo",
+          (unsigned long)(charge / total), (unsigned long)s->wakes, (unsigned long)s->wake_last_us,
+          (unsigned long)s->wake_max_us, (unsigned long)s->wakes_late);
+}
+
+void power_init(void) {
+    entered_us = time_us_32();
+    enter(POWER_ACTIVE);
+    sched_after(POWER_REPORT_US, POWER_REPORT_US, report, NULL);
+}
@@ -0,0 +1,71 @@
+#ifndef POWER_H
+#define POWER_H
+
+// Gerência de energia por inatividade: sem eventos de entrada o sistema passa
+// de ativo para contraste reduzido, painel e LEDs desligados e, por fim, sono
+// (varredura de botões e teclado parada, despertar por borda de GPIO; o
+// joystick segue amostrado). Qualquer entrada volta ao estado ativo; a
+// entrada que acorda o painel desligado não chega ao menu. O OLED mantém a RAM
+// com o painel desligado e a matriz recebe de volta o último quadro, então o
+// despertar só liga o painel: o tempo do evento até o painel aceso é medido e
+// comparado com POWER_WAKE_TARGET_US.
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "input.h"
+
+// Tempos sem entrada (a partir do último evento) para cada estado
+#define POWER_DIM_US 20000000       // 20 s
+#define POWER_OFF_US 60000000       // 1 min
+#define POWER_SLEEP_US 90000000     // 1 min 30 s
+
+#define POWER_CONTRAST_ACTIVE 0xFF
+#define POWER_CONTRAST_DIM 0x10
+
+#define POWER_WAKE_TARGET_US 20000  // Evento -> painel aceso
+#define POWER_WAKE_GUARD_US 50000   // Depois de acordar, descarta o pressionamento que acordou
+#define POWER_REPORT_US 60000000    // Período do relatório por estado
+
+// Modelo de corrente para o relatório (estimativas a partir dos datasheets do
+// RP2040 a 125 MHz e de um SSD1306 0,96" com metade dos pixels acesos)
+#define POWER_CPU_RUN_MA 24         // Núcleos executando
+#define POWER_CPU_WFI_MA 8          // Núcleos em WFI/WFE, periféricos e USB ligados
+#define POWER_OLED_MA 12            // Contraste máximo
+#define POWER_OLED_DIM_MA 3
+
+typedef enum {
+    POWER_ACTIVE,
+    POWER_DIM,
+    POWER_OFF,
+    POWER_SLEEP,
+    POWER_STATE_COUNT
+} power_state_t;
+
+typedef struct {
+    uint64_t time_us;     // Tempo total no estado
+    uint64_t idle_us;     // ... com o núcleo 0 dormindo
+    uint32_t entries;
+} power_state_stats_t;
+
+typedef struct {
+    power_state_stats_t states[POWER_STATE_COUNT];
+    uint32_t wake_last_us;  // Evento -> painel aceso
+    uint32_t wake_max_us;
+    uint32_t wakes;
+    uint32_t wakes_late;    // Acima de POWER_WAKE_TARGET_US
+} power_stats_t;
+
+void power_init(void);
+
+// Para cada evento de entrada, antes do menu. Retorna true se o evento só
+// acordou o sistema e deve ser descartado.
+bool power_event(const input_event_t *event);
+
+// Loop principal: conclui a medição do despertar
+void power_tick(void);
+
+void power_record_idle(uint32_t idle_us);
+power_state_t power_state(void);
+const power_stats_t *power_stats(void);
+
+#endif // POWER_H
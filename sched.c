@@ -0,0 +1,71 @@
+#include <stddef.h>
+#include "sched.h"
+#include "pico/stdlib.h"
+
+typedef struct {
+    sched_fn_t fn;          // NULL: posição livre
+    void *arg;
+    uint32_t deadline_us;
+    uint32_t period_us;
+    uint8_t generation;     // Invalida identificadores antigos quando a posição é reutilizada
+} task_t;
+
+static task_t tasks[SCHED_MAX_TASKS];
+
+// Identificador = posição | geração << 8
+static task_t *task_of(int id) {
+    if (id < 0 || (id & 0xFF) >= SCHED_MAX_TASKS)
+        return NULL;
+    task_t *t = &tasks[id & 0xFF];
+    return t->fn && t->generation == (uint8_t)(id >> 8) ? t : NULL;
+}
+
+int sched_after(uint32_t delay_us, uint32_t period_us, sched_fn_t fn, void *arg) {
+    for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+        task_t *t = &tasks[i];
+        if (t->fn)
+            continue;
+        t->generation++;
+        t->fn = fn;
+        t->arg = arg;
+        t->deadline_us = time_us_32() + delay_us;
+        t->period_us = period_us;
+        return i | t->generation << 8;
+    }
+    return SCHED_INVALID;
+}
+
+void sched_cancel(int id) {
+    task_t *t = task_of(id);
+    if (t)
+        t->fn = NULL;
+}
+
+void sched_postpone(int id, uint32_t delay_us) {
+    task_t *t = task_of(id);
+    if (t)
+        t->deadline_us = time_us_32() + delay_us;
+}
+
+bool sched_pending(int id) {
+    return task_of(id) != NULL;
+}
+
+void sched_tick(uint32_t now_us) {
+    for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+        task_t *t = &tasks[i];
+        if (!t->fn || (int32_t)(now_us - t->deadline_us) < 0)
+            continue;
+        sched_fn_t fn = t->fn;
+        void *arg = t->arg;
+        if (t->period_us) {
+            // Sem rajadas de recuperação: um atraso longo gera um único disparo
+            t->deadline_us += t->period_us;
+            if ((int32_t)(now_us - t->deadline_us) >= 0)
+                t->deadline_us = now_us + t->period_us;
+        } else {
+            t->fn = NULL; // Liberada antes da chamada: fn pode agendar de novo
+        }
+        fn(arg);
+    }
+}
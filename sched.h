@@ -0,0 +1,31 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+// Agendador cooperativo por prazos: tarefas de disparo único ou periódicas,
+// executadas por sched_tick no loop principal (núcleo 0). A resolução é a do
+// loop, que acorda a cada interrupção (no mínimo a cada INPUT_SAMPLE_MS).
+// Não é reentrante entre núcleos nem para uso em interrupções.
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SCHED_MAX_TASKS 12
+#define SCHED_INVALID (-1)
+
+typedef void (*sched_fn_t)(void *arg);
+
+// Agenda fn para daqui a delay_us e, se period_us > 0, a cada period_us depois
+// disso. Retorna o identificador da tarefa ou SCHED_INVALID com a tabela cheia.
+int sched_after(uint32_t delay_us, uint32_t period_us, sched_fn_t fn, void *arg);
+
+// Cancela (identificadores já vencidos ou cancelados são ignorados)
+void sched_cancel(int id);
+
+// Move o próximo disparo para daqui a delay_us
+void sched_postpone(int id, uint32_t delay_us);
+
+bool sched_pending(int id);
+
+// Executa as tarefas vencidas
+void sched_tick(uint32_t now_us);
+
+#endif // SCHED_H
@@ -0,0 +1,107 @@
+#include <stddef.h>
+#include "screen.h"
+#include "sched.h"
+#include "output.h"
+#include "log.h"
+
+typedef struct {
+    const screen_t *screen;
+    void *ctx;
+    int timeout_task;
+    int refresh_task;
+} entry_t;
+
+static entry_t stack[SCREEN_STACK_DEPTH];
+static uint depth;
+static bool dirty;
+static void (*empty_cb)(void);
+
+void screen_init(void (*on_empty)(void)) {
+    empty_cb = on_empty;
+}
+
+bool screen_active(void) {
+    return depth > 0;
+}
+
+// Fecha as telas do topo até restarem keep
+static void close_to(uint keep) {
+    while (depth > keep) {
+        entry_t *e = &stack[--depth];
+        sched_cancel(e->timeout_task);
+        sched_cancel(e->refresh_task);
+        if (e->screen->exit)
+            e->screen->exit(e->ctx);
+    }
+    if (depth > 0)
+        dirty = true;
+    else if (empty_cb)
+        empty_cb();
+}
+
+// Prazo de uma tela: fecha ela e as que estiverem por cima
+static void timeout_cb(void *arg) {
+    entry_t *e = arg;
+    close_to((uint)(e - stack));
+}
+
+static void refresh_cb(void *arg) {
+    entry_t *e = arg;
+    if (!e->screen->update || e->screen->update(e->ctx)) {
+        if (e == &stack[depth - 1])
+            dirty = true;
+    }
+}
+
+bool screen_push(const screen_t *screen, void *ctx) {
+    if (depth == SCREEN_STACK_DEPTH) {
+        LOG_W(LOG_MENU, "Pilha de telas cheia, '%s' ignorada", screen->name);
+        return false;
+    }
+    entry_t *e = &stack[depth++];
+    *e = (entry_t){screen, ctx, SCHED_INVALID, SCHED_INVALID};
+    if (screen->timeout_us)
+        e->timeout_task = sched_after(screen->timeout_us, 0, timeout_cb, e);
+    if (screen->refresh_us)
+        e->refresh_task = sched_after(screen->refresh_us, screen->refresh_us, refresh_cb, e);
+    if (screen->enter)
+        screen->enter(ctx);
+    // Desenha já: a tela aparece sem esperar a próxima volta do loop
+    dirty = true;
+    screen_render();
+    return true;
+}
+
+void screen_pop(void) {
+    if (depth > 0)
+        close_to(depth - 1);
+}
+
+void screen_close_all(void) {
+    if (depth > 0)
+        close_to(0);
+}
+
+bool screen_event(const input_event_t *event) {
+    if (depth == 0)
+        return false;
+    entry_t *e = &stack[depth - 1];
+    if (e->screen->event && e->screen->event(e->ctx, event))
+        return true;
+    if (event->type == INPUT_BACK)
+        screen_pop(); // Botão A cancela a tela
+    return true;      // Com uma tela aberta, o menu não recebe eventos
+}
+
+void screen_invalidate(void) {
+    dirty = true;
+}
+
+void screen_render(void) {
+    if (!dirty || depth == 0)
+        return;
+    dirty = false;
+    entry_t *e = &stack[depth - 1];
+    e->screen->draw(e->ctx);
+    output_frame_ready();
+}
@@ -0,0 +1,41 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+// Pilha de telas cooperativa sobre o menu: uma ação abre uma tela e retorna na
+// hora; a tela do topo recebe os eventos de entrada, é redesenhada quando muda
+// e fecha pelo próprio prazo, pelo Botão A (INPUT_BACK) ou por screen_pop. Os
+// prazos e a atualização periódica são tarefas do agendador (sched.h).
+// Com a pilha vazia, o menu volta a ser desenhado.
+#include <stdbool.h>
+#include <stdint.h>
+#include "input.h"
+
+#define SCREEN_STACK_DEPTH 4
+
+typedef struct {
+    const char *name;
+    void (*enter)(void *ctx);                                  // Ao abrir (opcional)
+    void (*draw)(void *ctx);                                   // Desenha a tela inteira no ram_buffer
+    bool (*update)(void *ctx);                                 // A cada refresh_us; true = redesenhar
+    bool (*event)(void *ctx, const input_event_t *event);      // true = evento tratado (opcional)
+    void (*exit)(void *ctx);                                   // Ao fechar (opcional)
+    uint32_t timeout_us;                                       // Fecha sozinha após o prazo (0 = não fecha)
+    uint32_t refresh_us;                                       // Período de update (0 = sem update)
+} screen_t;
+
+// on_empty é chamado quando a última tela fecha (para o menu se redesenhar)
+void screen_init(void (*on_empty)(void));
+
+bool screen_push(const screen_t *screen, void *ctx);
+void screen_pop(void);
+void screen_close_all(void);
+bool screen_active(void);
+
+// Entrega um evento à tela do topo; false se não há tela aberta
+bool screen_event(const input_event_t *event);
+
+// Marca a tela do topo para redesenho e, em screen_render, publica o quadro
+void screen_invalidate(void);
+void screen_render(void);
+
+#endif // SCREEN_H
@@ -1,5 +1,37 @@
+#include <string.h>
 #include "ssd1306.h"
-#include "font.h"
+#include "ssd1306_hal.h"
+#include "font_atlas.h" // Gerado a partir de font.h e font_extra.h
+
+// Custo em bytes de um quadro completo no método antigo: 6 comandos avulsos + buffer inteiro
+#define SSD1306_FULL_FRAME_COST(ssd) ((ssd)->bufsize + 6 * 2)
+
+// Amplia a faixa alterada das páginas page0..page1 para incluir as colunas x0..x1
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  for (uint8_t page = page0; page <= page1; ++page) {
+    if (x0 < ssd->dirty_x0[page])
+      ssd->dirty_x0[page] = x0;
+    if (x1 > ssd->dirty_x1[page])
+      ssd->dirty_x1[page] = x1;
+  }
+}
+
+static inline void ssd1306_clear_dirty(ssd1306_t *ssd) {
+  memset(ssd->dirty_x0, 0xFF, sizeof(ssd->dirty_x0));
+  memset(ssd->dirty_x1, 0x00, sizeof(ssd->dirty_x1));
+}
+
+static inline void ssd1306_clear_pending(ssd1306_t *ssd) {
+  memset(ssd->pending_x0, 0xFF, sizeof(ssd->pending_x0));
+  memset(ssd->pending_x1, 0x00, sizeof(ssd->pending_x1));
+}
+
+static inline void ssd1306_mark_pending(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page) {
+  if (x0 < ssd->pending_x0[page])
+    ssd->pending_x0[page] = x0;
+  if (x1 > ssd->pending_x1[page])
+    ssd->pending_x1[page] = x1;
+}
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -10,111 +42,390 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->bufsize = ssd->pages * ssd->width + 1;
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
-  ssd->port_buffer[0] = 0x80;
+  ssd->cmd_queue[0] = 0x00; // Co = 0, D/C = 0: todos os bytes seguintes são comandos
+  ssd->cmd_count = 0;
+  ssd->front_buffer = calloc(ssd->bufsize - 1, sizeof(uint8_t));
+  // Pior caso: uma janela por página, cada uma com seus comandos de endereçamento,
+  // e a linha inicial
+  ssd->tx_words = calloc(ssd->pages * SSD1306_WINDOW_OVERHEAD + ssd->bufsize - 1 + 2, sizeof(uint16_t));
+  ssd->dma_channel = -1;
+  ssd->flush_busy = false;
+  ssd->frame_queued = false;
+  ssd->flush_done = NULL;
+  ssd->flush_ctx = NULL;
+  ssd->frames_started = 0;
+  ssd->bytes_sent = 0;
+  ssd->bytes_saved = 0;
+  ssd->last_saved = 0;
+  ssd->flush_start_us = 0;
+  ssd->last_flush_us = 0;
+  ssd1306_clear_dirty(ssd);
+  ssd1306_clear_pending(ssd);
+  ssd1306_invalidate(ssd); // Conteúdo da RAM do painel é desconhecido após o reset
+  ssd->start_line = ssd->front_start_line = 0;
+  ssd->panel_start_line = 0; // A sequência de inicialização a zera
 }
 
+void ssd1306_init_surface(ssd1306_t *ssd, uint8_t *buffer, uint8_t width, uint8_t height) {
+  memset(ssd, 0, sizeof(*ssd));
+  ssd->width = width;
+  ssd->height = height;
+  ssd->pages = height / 8U;
+  ssd->bufsize = ssd->pages * ssd->width + 1;
+  ssd->ram_buffer = buffer;
+  ssd->ram_buffer[0] = 0x40;
+  ssd->dma_channel = -1;
+  ssd1306_clear_dirty(ssd);
+}
+
+// Sequência de inicialização enviada em uma única transação de comandos
+static const uint8_t ssd1306_init_sequence[] = {
+  SET_DISP | 0x00,
+  SET_MEM_ADDR, 0x00, // Endereçamento horizontal: cada página é contígua no buffer
+  SET_DISP_START_LINE | 0x00,
+  SET_SEG_REMAP | 0x01,
+  SET_MUX_RATIO, HEIGHT - 1,
+  SET_COM_OUT_DIR | 0x08,
+  SET_DISP_OFFSET, 0x00,
+  SET_COM_PIN_CFG, 0x12,
+  SET_DISP_CLK_DIV, 0x80,
+  SET_PRECHARGE, 0xF1,
+  SET_VCOM_DESEL, 0x30,
+  SET_CONTRAST, 0xFF,
+  SET_ENTIRE_ON,
+  SET_NORM_INV,
+  SET_CHARGE_PUMP, 0x14,
+  SET_DISP | 0x01
+};
+
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  ssd1306_commands(ssd, ssd1306_init_sequence, sizeof(ssd1306_init_sequence));
+}
+
+// Acrescenta um byte de comando à fila; a fila é enviada quando enche ou em ssd1306_flush_commands
+void ssd1306_queue_command(ssd1306_t *ssd, uint8_t command) {
+  if (ssd->cmd_count == SSD1306_CMD_QUEUE_SIZE)
+    ssd1306_flush_commands(ssd);
+  ssd->cmd_queue[1 + ssd->cmd_count++] = command;
+}
+
+// Envia os comandos enfileirados numa única transação: byte de controle 0x00 seguido dos comandos
+void ssd1306_flush_commands(ssd1306_t *ssd) {
+  if (ssd->cmd_count == 0)
+    return;
+  ssd1306_flush_wait(ssd); // O barramento pode estar ocupado pela DMA
+  ssd1306_hal_write_blocking(ssd, ssd->cmd_queue, 1 + ssd->cmd_count);
+  ssd->cmd_count = 0;
+}
+
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  for (size_t i = 0; i < count; ++i)
+    ssd1306_queue_command(ssd, commands[i]);
+  ssd1306_flush_commands(ssd);
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
-}
-
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
-}
-
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  ssd1306_queue_command(ssd, command);
+  ssd1306_flush_commands(ssd);
+}
+
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast) {
+  ssd1306_queue_command(ssd, SET_CONTRAST);
+  ssd1306_queue_command(ssd, contrast);
+  ssd1306_flush_commands(ssd);
+}
+
+void ssd1306_set_display_on(ssd1306_t *ssd, bool on) {
+  ssd1306_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
+}
+
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line) {
+  ssd->start_line = line % ssd->height;
+}
+
+// Codifica a janela de colunas x0..x1 nas páginas page0..page1 a partir do front buffer:
+// uma transação com os seis comandos de endereçamento e outra com os dados
+static size_t ssd1306_encode_window(ssd1306_t *ssd, uint16_t *out, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  size_t n = 0;
+  out[n++] = 0x00;
+  out[n++] = SET_COL_ADDR;
+  out[n++] = x0;
+  out[n++] = x1;
+  out[n++] = SET_PAGE_ADDR;
+  out[n++] = page0;
+  out[n++] = page1 | SSD1306_HAL_STOP;
+
+  out[n++] = 0x40;
+  for (uint8_t page = page0; page <= page1; ++page) {
+    const uint8_t *src = &ssd->front_buffer[page * ssd->width];
+    for (uint8_t x = x0; x <= x1; ++x)
+      out[n++] = src[x];
+  }
+  out[n - 1] |= SSD1306_HAL_STOP;
+  return n;
+}
+
+// Monta em tx_words as janelas pendentes, agrupando páginas consecutivas
+// quando isso custa menos que enviá-las separadas
+static size_t ssd1306_encode_pending(ssd1306_t *ssd) {
+  const uint8_t *x0 = ssd->pending_x0;
+  const uint8_t *x1 = ssd->pending_x1;
+  size_t n = 0;
+  uint8_t page = 0;
+  while (page < ssd->pages) {
+    if (x0[page] > x1[page]) {
+      page++;
+      continue;
+    }
+    uint8_t page0 = page;
+    int wx0 = x0[page], wx1 = x1[page];
+    int cost = (wx1 - wx0 + 1) + SSD1306_WINDOW_OVERHEAD;
+    for (page++; page < ssd->pages && x0[page] <= x1[page]; page++) {
+      int mx0 = x0[page] < wx0 ? x0[page] : wx0;
+      int mx1 = x1[page] > wx1 ? x1[page] : wx1;
+      int merged = (mx1 - mx0 + 1) * (page - page0 + 1) + SSD1306_WINDOW_OVERHEAD;
+      int separate = cost + (x1[page] - x0[page] + 1) + SSD1306_WINDOW_OVERHEAD;
+      if (merged > separate)
+        break;
+      wx0 = mx0;
+      wx1 = mx1;
+      cost = merged;
+    }
+    n += ssd1306_encode_window(ssd, &ssd->tx_words[n], wx0, wx1, page0, page - 1);
+  }
+  // Depois dos dados: as linhas que a nova linha inicial expõe já estão no painel
+  if (ssd->front_start_line != ssd->panel_start_line) {
+    ssd->tx_words[n++] = 0x00;
+    ssd->tx_words[n++] = (SET_DISP_START_LINE | ssd->front_start_line) | SSD1306_HAL_STOP;
+    ssd->panel_start_line = ssd->front_start_line;
+  }
+  return n;
+}
+
+// Publica o ram_buffer (back) no front buffer. Só as colunas que realmente mudaram
+// são copiadas e passam a aguardar envio; a aplicação pode continuar desenhando logo em seguida.
+void ssd1306_swap(ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    int x0 = ssd->dirty_x0[page];
+    int x1 = ssd->dirty_x1[page];
+    const uint8_t *back = &ssd->ram_buffer[1 + page * ssd->width];
+    uint8_t *front = &ssd->front_buffer[page * ssd->width];
+    while (x0 <= x1 && back[x0] == front[x0])
+      x0++;
+    while (x1 >= x0 && back[x1] == front[x1])
+      x1--;
+    if (x0 > x1)
+      continue;
+    memcpy(&front[x0], &back[x0], x1 - x0 + 1);
+    ssd1306_mark_pending(ssd, x0, x1, page);
+  }
+  ssd1306_clear_dirty(ssd);
+  ssd->front_start_line = ssd->start_line;
+}
+
+// Inicia o envio das janelas pendentes. Se um envio já estiver em andamento,
+// o quadro fica enfileirado e parte assim que ssd1306_flush_poll detectar o fim do atual.
+// Retorna true se uma transferência foi iniciada agora.
+bool ssd1306_flush_start(ssd1306_t *ssd) {
+  if (ssd->flush_busy) {
+    ssd->frame_queued = true;
+    return false;
+  }
+  ssd->frame_queued = false;
+
+  size_t count = ssd1306_encode_pending(ssd);
+  ssd1306_clear_pending(ssd);
+
+  size_t full = SSD1306_FULL_FRAME_COST(ssd);
+  ssd->bytes_sent = count;
+  ssd->last_saved = count < full ? full - count : 0;
+  ssd->bytes_saved += ssd->last_saved;
+  if (count == 0)
+    return false; // Nada mudou: nenhum tráfego no barramento
+
+  ssd->flush_busy = true;
+  ssd->frames_started++;
+  ssd->flush_start_us = ssd1306_hal_time_us();
+  ssd1306_hal_dma_start(ssd, ssd->tx_words, count);
+  return true;
+}
+
+// Avança a máquina de estados do envio; retorna true enquanto houver transferência em curso
+bool ssd1306_flush_poll(ssd1306_t *ssd) {
+  if (!ssd->flush_busy)
+    return false;
+  ssd1306_hal_status_t status = ssd1306_hal_dma_poll(ssd);
+  if (status == SSD1306_HAL_BUSY)
+    return true;
+
+  ssd->flush_busy = false;
+  ssd->last_flush_us = (uint32_t)(ssd1306_hal_time_us() - ssd->flush_start_us);
+  if (status == SSD1306_HAL_ERROR) {
+    ssd1306_invalidate(ssd);
+    ssd->panel_start_line = 0xFF;
+  }
+  if (ssd->flush_done)
+    ssd->flush_done(ssd, ssd->flush_ctx);
+  if (ssd->frame_queued)
+    ssd1306_flush_start(ssd);
+  return ssd->flush_busy;
+}
+
+// Aguarda o fim de todos os envios, inclusive de um quadro enfileirado
+void ssd1306_flush_wait(ssd1306_t *ssd) {
+  while (ssd1306_flush_poll(ssd))
+    ;
+}
+
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *ctx) {
+  ssd->flush_done = cb;
+  ssd->flush_ctx = ctx;
+}
+
+// Envio síncrono: publica o ram_buffer e espera a transmissão das regiões alteradas.
+// Retorna quantos bytes foram economizados em relação ao envio do quadro completo.
+size_t ssd1306_send_data(ssd1306_t *ssd) {
+  ssd1306_swap(ssd);
+  ssd1306_flush_wait(ssd);
+  ssd1306_flush_start(ssd);
+  ssd1306_flush_wait(ssd);
+  return ssd->last_saved;
+}
+
+// Marca o front buffer inteiro como pendente, forçando o próximo envio a transmitir o quadro completo
+void ssd1306_invalidate(ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < ssd->pages; ++page)
+    ssd1306_mark_pending(ssd, 0, ssd->width - 1, page);
+}
+
+void ssd1306_pixel(ssd1306_t *ssd, int x, int y, bool value) {
+  if (x < 0 || y < 0 || x >= ssd->width || y >= ssd->height)
+    return;
+  uint8_t page = y >> 3;
+  uint16_t index = page * ssd->width + x + 1;
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
   else
     ssd->ram_buffer[index] &= ~(1 << pixel);
+  ssd1306_mark_dirty(ssd, x, x, page, page);
 }
 
-/*
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
-
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, ssd->bufsize - 1);
+  ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
 }
 
+// Acesso em palavras de 32 bits ao framebuffer (que é alocado como bytes)
+typedef uint32_t __attribute__((may_alias)) ssd1306_word_t;
 
+// Aplica a máscara de bits mask às colunas x0..x1 de uma página.
+// As colunas de uma página são contíguas, então o miolo é processado 4 bytes por vez.
+static void ssd1306_span(uint8_t *row, int x0, int x1, uint8_t mask, ssd1306_mode_t mode) {
+  uint8_t *p = &row[x0];
+  uint8_t *end = &row[x1 + 1];
+  uint32_t wmask = mask * 0x01010101u;
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+  switch (mode) {
+    case SSD1306_CLEAR:
+      for (; p < end && ((uintptr_t)p & 3); ++p)
+        *p &= ~mask;
+      for (; end - p >= 4; p += 4)
+        *(ssd1306_word_t *)p &= ~wmask;
+      for (; p < end; ++p)
+        *p &= ~mask;
+      break;
+    case SSD1306_SET:
+      for (; p < end && ((uintptr_t)p & 3); ++p)
+        *p |= mask;
+      for (; end - p >= 4; p += 4)
+        *(ssd1306_word_t *)p |= wmask;
+      for (; p < end; ++p)
+        *p |= mask;
+      break;
+    case SSD1306_INVERT:
+      for (; p < end && ((uintptr_t)p & 3); ++p)
+        *p ^= mask;
+      for (; end - p >= 4; p += 4)
+        *(ssd1306_word_t *)p ^= wmask;
+      for (; p < end; ++p)
+        *p ^= mask;
+      break;
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+}
+
+// Primitiva base: retângulo preenchido com cantos (x0, y0) e (x1, y1) inclusivos.
+// O recorte é feito uma única vez; depois cada página recebe uma máscara de bits,
+// o que cobre linhas horizontais (uma linha da página) e verticais (uma coluna).
+static void ssd1306_fill_area(ssd1306_t *ssd, int x0, int y0, int x1, int y1, ssd1306_mode_t mode) {
+  if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+  if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 >= ssd->width) x1 = ssd->width - 1;
+  if (y1 >= ssd->height) y1 = ssd->height - 1;
+  if (x0 > x1 || y0 > y1)
+    return;
+
+  int page0 = y0 >> 3, page1 = y1 >> 3;
+  for (int page = page0; page <= page1; ++page) {
+    uint8_t mask = 0xFF;
+    if (page == page0)
+      mask &= 0xFF << (y0 & 7);
+    if (page == page1)
+      mask &= 0xFF >> (7 - (y1 & 7));
+    ssd1306_span(&ssd->ram_buffer[1 + page * ssd->width], x0, x1, mask, mode);
   }
+  ssd1306_mark_dirty(ssd, x0, x1, page0, page1);
+}
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+void ssd1306_fill_rect(ssd1306_t *ssd, int top, int left, int width, int height, ssd1306_mode_t mode) {
+  if (width <= 0 || height <= 0)
+    return;
+  ssd1306_fill_area(ssd, left, top, left + width - 1, top + height - 1, mode);
+}
+
+// Contorno: as laterais não repetem os cantos, para que o modo SSD1306_INVERT
+// desenhe e apague o mesmo contorno sem deixar resíduos
+void ssd1306_draw_rect(ssd1306_t *ssd, int top, int left, int width, int height, ssd1306_mode_t mode) {
+  if (width <= 0 || height <= 0)
+    return;
+  int right = left + width - 1;
+  int bottom = top + height - 1;
+  ssd1306_fill_area(ssd, left, top, right, top, mode);
+  if (bottom != top)
+    ssd1306_fill_area(ssd, left, bottom, right, bottom, mode);
+  if (height > 2) {
+    ssd1306_fill_area(ssd, left, top + 1, left, bottom - 1, mode);
+    if (right != left)
+      ssd1306_fill_area(ssd, right, top + 1, right, bottom - 1, mode);
   }
 }
 
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+void ssd1306_blit_page(ssd1306_t *ssd, uint8_t page, const uint8_t *src, uint8_t mask) {
+  if (page >= ssd->pages || mask == 0)
+    return;
+  uint8_t *dst = &ssd->ram_buffer[1 + page * ssd->width];
+  for (uint8_t x = 0; x < ssd->width; ++x)
+    dst[x] = (uint8_t)((dst[x] & ~mask) | (src[x] & mask));
+  ssd1306_mark_dirty(ssd, 0, ssd->width - 1, page, page);
+}
+
+void ssd1306_rect(ssd1306_t *ssd, int top, int left, int width, int height, bool value, bool fill) {
+  ssd1306_mode_t mode = value ? SSD1306_SET : SSD1306_CLEAR;
+  if (fill)
+    ssd1306_fill_rect(ssd, top, left, width, height, mode);
+  else
+    ssd1306_draw_rect(ssd, top, left, width, height, mode);
+}
+
+void ssd1306_line(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value) {
+    // Linhas horizontais e verticais usam o caminho por máscaras
+    if (x0 == x1 || y0 == y1) {
+        ssd1306_fill_area(ssd, x0, y0, x1, y1, value ? SSD1306_SET : SSD1306_CLEAR);
+        return;
+    }
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
 
@@ -143,80 +454,112 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 }
 
 
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+void ssd1306_hline(ssd1306_t *ssd, int x0, int x1, int y, bool value) {
+  ssd1306_fill_area(ssd, x0, y, x1, y, value ? SSD1306_SET : SSD1306_CLEAR);
 }
 
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+void ssd1306_vline(ssd1306_t *ssd, int x, int y0, int y1, bool value) {
+  ssd1306_fill_area(ssd, x, y0, x, y1, value ? SSD1306_SET : SSD1306_CLEAR);
 }
 
-/*
-//Função anterior para desenhar um caractere Maiúsculo
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-  uint16_t index = 0;
-  char ver=c;
-  if (c >= 'A' && c <= 'Z')
-  {
-    index = (c - 'A' + 11) * 8; // Para letras maiúsculas
-  }else  if (c >= '0' && c <= '9')
-  {
-    index = (c - '0' + 1) * 8; // Adiciona o deslocamento necessário
+// Decodifica o próximo caractere UTF-8 de *str e avança o ponteiro.
+// Sequências inválidas ou truncadas viram U+FFFD (desenhado como '?').
+uint32_t ssd1306_utf8_next(const char **str) {
+  const uint8_t *s = (const uint8_t *)*str;
+  uint32_t cp = *s++;
+  int extra = 0;
+  if (cp >= 0xF0 && cp < 0xF8) {
+    cp &= 0x07;
+    extra = 3;
+  } else if (cp >= 0xE0) {
+    cp &= 0x0F;
+    extra = 2;
+  } else if (cp >= 0xC0) {
+    cp &= 0x1F;
+    extra = 1;
+  } else if (cp >= 0x80) {
+    cp = 0xFFFD; // Byte de continuação sem início
   }
-  
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+  for (; extra > 0; --extra) {
+    if ((*s & 0xC0) != 0x80) {
+      cp = 0xFFFD;
+      break;
     }
+    cp = (cp << 6) | (*s++ & 0x3F);
   }
+  *str = (const char *)s;
+  return cp;
 }
-*/
 
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-    uint16_t index = 0;
-
-    if (c >= 'A' && c <= 'Z') {
-        index = (c - 'A' + 11) * 8; // Índice para letras maiúsculas
-    } else if (c >= '0' && c <= '9') {
-        index = (c - '0' + 1) * 8; // Índice para números
-    } else if (c >= 'a' && c <= 'z') {
-        index = (c - 'a' + 37) * 8; // Índice para letras minúsculas
-    } else {
-        return; // Caractere não suportado
-    }
+// Número de glifos (não de bytes) de uma string UTF-8
+size_t ssd1306_utf8_length(const char *str) {
+  size_t n = 0;
+  while (*str) {
+    ssd1306_utf8_next(&str);
+    n++;
+  }
+  return n;
+}
 
-    for (uint8_t i = 0; i < 8; ++i) {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
-        }
-    }
+// Copia as colunas de um glifo para o framebuffer, substituindo o fundo.
+// Com y alinhado à página cada coluna é um byte inteiro; caso contrário cada
+// coluna vira dois bytes deslocados, um em cada página atravessada.
+static void ssd1306_blit_glyph(ssd1306_t *ssd, const uint8_t *glyph, int x, int y) {
+  int c0 = x < 0 ? -x : 0;
+  int c1 = ssd->width - x < FONT_ATLAS_GLYPH_WIDTH ? ssd->width - x : FONT_ATLAS_GLYPH_WIDTH;
+  if (c0 >= c1 || y <= -8 || y >= ssd->height)
+    return;
+
+  int page = (y >= 0) ? y / 8 : -((-y + 7) / 8);
+  int shift = y - page * 8;
+
+  if (shift == 0) {
+    memcpy(&ssd->ram_buffer[1 + page * ssd->width + x + c0], &glyph[c0], c1 - c0);
+    ssd1306_mark_dirty(ssd, x + c0, x + c1 - 1, page, page);
+    return;
+  }
+
+  if (page >= 0) {
+    uint8_t *top = &ssd->ram_buffer[1 + page * ssd->width + x];
+    uint8_t keep = 0xFF >> (8 - shift);
+    for (int c = c0; c < c1; ++c)
+      top[c] = (top[c] & keep) | (uint8_t)(glyph[c] << shift);
+    ssd1306_mark_dirty(ssd, x + c0, x + c1 - 1, page, page);
+  }
+  if (page + 1 < ssd->pages) {
+    uint8_t *bottom = &ssd->ram_buffer[1 + (page + 1) * ssd->width + x];
+    uint8_t keep = 0xFF << shift;
+    for (int c = c0; c < c1; ++c)
+      bottom[c] = (bottom[c] & keep) | (glyph[c] >> (8 - shift));
+    ssd1306_mark_dirty(ssd, x + c0, x + c1 - 1, page + 1, page + 1);
+  }
+}
+
+// Desenha o glifo de um code point (ASCII imprimível ou Latin-1)
+void ssd1306_draw_glyph(ssd1306_t *ssd, uint32_t codepoint, int x, int y) {
+  ssd1306_blit_glyph(ssd, font_atlas[font_atlas_index(codepoint)], x, y);
 }
 
+// Desenha um caractere isolado; bytes acima de 0x7F são interpretados como Latin-1
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int x, int y) {
+  ssd1306_draw_glyph(ssd, (uint8_t)c, x, y);
+}
 
-// Função para desenhar uma string
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+// Função para desenhar uma string UTF-8
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, int x, int y)
 {
   while (*str)
   {
-    ssd1306_draw_char(ssd, *str++, x, y);
-    x += 8;
-    if (x + 8 >= ssd->width)
+    ssd1306_draw_glyph(ssd, ssd1306_utf8_next(&str), x, y);
+    x += FONT_ATLAS_GLYPH_WIDTH;
+    if (x + FONT_ATLAS_GLYPH_WIDTH > ssd->width)
     {
       x = 0;
       y += 8;
     }
-    if (y + 8 >= ssd->height)
+    if (y + 8 > ssd->height)
     {
       break;
     }
   }
-}
\ No newline at end of file
+}
@@ -1,9 +1,22 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
+#ifdef SSD1306_HAL_MOCK
+// Backend simulado (host Linux): sem dependências do Pico SDK
+#include <stdbool.h>
+#include <stdint.h>
+typedef struct i2c_inst i2c_inst_t;
+#else
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#endif
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_MAX_PAGES 8        // 64 linhas / 8 linhas por página
+#define SSD1306_WINDOW_OVERHEAD 8  // Controle + 6 comandos de janela + controle dos dados
+#define SSD1306_CMD_QUEUE_SIZE 32  // Comporta a sequência de inicialização inteira
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -22,28 +35,100 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  // Rolagem contínua (não usada: a lista rola pela linha inicial, ver list_view.h)
+  SET_HSCROLL_RIGHT = 0x26,
+  SET_HSCROLL_LEFT = 0x27,
+  SET_VHSCROLL_RIGHT = 0x29,
+  SET_VHSCROLL_LEFT = 0x2A,
+  SET_SCROLL_OFF = 0x2E,
+  SET_SCROLL_ON = 0x2F,
+  SET_VSCROLL_AREA = 0xA3
 } ssd1306_command_t;
 
-typedef struct {
+// Modo de desenho das primitivas de área: apagar, acender ou inverter (XOR)
+typedef enum {
+  SSD1306_CLEAR = 0,
+  SSD1306_SET = 1,
+  SSD1306_INVERT = 2
+} ssd1306_mode_t;
+
+typedef struct ssd1306 ssd1306_t;
+
+// Chamado por ssd1306_flush_poll quando um quadro termina de ser transmitido
+typedef void (*ssd1306_flush_cb_t)(ssd1306_t *ssd, void *ctx);
+
+struct ssd1306 {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
-  uint8_t port_buffer[2];
-} ssd1306_t;
+  uint8_t cmd_queue[1 + SSD1306_CMD_QUEUE_SIZE]; // Byte de controle 0x00 + comandos enfileirados
+  uint8_t cmd_count;
+  // Faixa de colunas alterada em cada página (x0 > x1 indica página limpa)
+  uint8_t dirty_x0[SSD1306_MAX_PAGES];   // ram_buffer (back) em relação ao front
+  uint8_t dirty_x1[SSD1306_MAX_PAGES];
+  uint8_t pending_x0[SSD1306_MAX_PAGES]; // front em relação ao painel
+  uint8_t pending_x1[SSD1306_MAX_PAGES];
+  uint8_t *front_buffer;  // Último quadro publicado por ssd1306_swap
+  // Linha da RAM exibida no topo do painel (SET_DISP_START_LINE): definida com o
+  // desenho, publicada por swap e enviada depois dos dados do mesmo quadro
+  uint8_t start_line;
+  uint8_t front_start_line;
+  uint8_t panel_start_line; // 0xFF: desconhecida
+  uint16_t *tx_words;     // Fluxo IC_DATA_CMD lido pela DMA (janelas do quadro em envio)
+  int dma_channel;        // Canal de DMA do backend (-1 até o primeiro envio)
+  volatile bool flush_busy;
+  bool frame_queued;      // Novo quadro pedido enquanto o anterior era enviado
+  ssd1306_flush_cb_t flush_done;
+  void *flush_ctx;
+  uint32_t frames_started; // Quadros entregues à DMA desde a inicialização
+  uint32_t bytes_sent;    // Bytes transmitidos no último envio
+  uint32_t bytes_saved;   // Total acumulado de bytes economizados
+  uint32_t last_saved;    // Bytes economizados no último envio
+  uint64_t flush_start_us;
+  uint32_t last_flush_us; // Duração do último envio (do início até o fim detectado pelo poll)
+};
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
+// Superfície só de desenho (sem painel nem envio): buffer com 1 + width * height / 8 bytes
+void ssd1306_init_surface(ssd1306_t *ssd, uint8_t *buffer, uint8_t width, uint8_t height);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
-void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count);
+void ssd1306_queue_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_flush_commands(ssd1306_t *ssd);
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast);
+void ssd1306_set_display_on(ssd1306_t *ssd, bool on); // Desligado, a RAM do painel é mantida
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line); // Vale a partir do próximo swap
+size_t ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+
+// Envio assíncrono: desenhe no ram_buffer, publique com swap e inicie o envio
+void ssd1306_swap(ssd1306_t *ssd);
+bool ssd1306_flush_start(ssd1306_t *ssd);
+bool ssd1306_flush_poll(ssd1306_t *ssd);
+void ssd1306_flush_wait(ssd1306_t *ssd);
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *ctx);
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
+// Coordenadas fora da tela são recortadas (inclusive negativas)
+void ssd1306_pixel(ssd1306_t *ssd, int x, int y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_rect(ssd1306_t *ssd, int top, int left, int width, int height, bool value, bool fill);
+void ssd1306_fill_rect(ssd1306_t *ssd, int top, int left, int width, int height, ssd1306_mode_t mode);
+void ssd1306_draw_rect(ssd1306_t *ssd, int top, int left, int width, int height, ssd1306_mode_t mode);
+// Copia de src (uma página, width bytes) só as linhas de mask (bit 0 = linha de cima)
+void ssd1306_blit_page(ssd1306_t *ssd, uint8_t page, const uint8_t *src, uint8_t mask);
+void ssd1306_line(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value);
+void ssd1306_hline(ssd1306_t *ssd, int x0, int x1, int y, bool value);
+void ssd1306_vline(ssd1306_t *ssd, int x, int y0, int y1, bool value);
+void ssd1306_draw_glyph(ssd1306_t *ssd, uint32_t codepoint, int x, int y);
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int x, int y);
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, int x, int y);
+
+// Texto UTF-8: os caracteres fora de ASCII/Latin-1 são desenhados como '?'
+uint32_t ssd1306_utf8_next(const char **str);
+size_t ssd1306_utf8_length(const char *str);
+
+#endif // SSD1306_H
@@ -0,0 +1,45 @@
+#ifndef SSD1306_HAL_H
+#define SSD1306_HAL_H
+
+// Camada de transporte do SSD1306: o driver só conversa com o barramento por aqui.
+// ssd1306_hal_pico.c implementa sobre I2C + DMA do RP2040;
+// ssd1306_hal_mock.c (compilado com SSD1306_HAL_MOCK) simula o painel no host.
+#include "ssd1306.h"
+
+// Bit STOP do registro IC_DATA_CMD: encerra a transação I2C após este byte
+#define SSD1306_HAL_STOP 0x0200u
+
+typedef enum {
+  SSD1306_HAL_BUSY,
+  SSD1306_HAL_DONE,
+  SSD1306_HAL_ERROR // Transação abortada (NACK); o conteúdo do painel é incerto
+} ssd1306_hal_status_t;
+
+// Transação única e bloqueante (comandos de configuração)
+void ssd1306_hal_write_blocking(ssd1306_t *ssd, const uint8_t *src, size_t len);
+
+// Inicia a DMA de count palavras IC_DATA_CMD; cada SSD1306_HAL_STOP fecha uma transação
+void ssd1306_hal_dma_start(ssd1306_t *ssd, const uint16_t *words, size_t count);
+
+// Estado da transferência iniciada por ssd1306_hal_dma_start
+ssd1306_hal_status_t ssd1306_hal_dma_poll(ssd1306_t *ssd);
+
+// Relógio em microssegundos para as medições de envio
+uint64_t ssd1306_hal_time_us(void);
+
+#ifdef SSD1306_HAL_MOCK
+// Controle do backend simulado
+void ssd1306_hal_mock_reset(void);
+void ssd1306_hal_mock_set_bus_hz(uint32_t hz);    // Velocidade usada para simular o tempo de barramento
+void ssd1306_hal_mock_set_clock(uint64_t (*clock)(void), void (*wait_us)(uint64_t us));
+void ssd1306_hal_mock_complete(bool ok);          // Conclui a DMA em andamento
+bool ssd1306_hal_mock_dma_active(void);
+size_t ssd1306_hal_mock_transactions(void);       // Transações I2C recebidas
+size_t ssd1306_hal_mock_bytes(void);              // Bytes recebidos (incluindo controle)
+const uint8_t *ssd1306_hal_mock_panel(void);      // RAM do painel, página a página
+bool ssd1306_hal_mock_display_on(void);           // Último SET_DISP recebido
+uint8_t ssd1306_hal_mock_contrast(void);          // Último SET_CONTRAST recebido
+uint8_t ssd1306_hal_mock_start_line(void);        // Linha da RAM no topo (SET_DISP_START_LINE)
+#endif
+
+#endif // SSD1306_HAL_H
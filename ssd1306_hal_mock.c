@@ -0,0 +1,226 @@
+#include <string.h>
+#include "ssd1306_hal.h"
+
+// Backend simulado para o host: decodifica o fluxo I2C como um SSD1306 em
+// endereçamento horizontal e mantém a DMA "em andamento" até que o teste
+// chame ssd1306_hal_mock_complete. O relógio avança com o tempo que cada
+// transação levaria no barramento (9 bits por byte, mais endereço, START e STOP).
+// Com um relógio externo (ssd1306_hal_mock_set_clock, usado pela simulação do
+// host), a DMA conclui sozinha quando esse relógio passa do tempo de barramento.
+
+static struct {
+  uint8_t panel[SSD1306_MAX_PAGES * WIDTH];
+  uint8_t col0, col1, page0, page1; // Janela definida por SET_COL_ADDR/SET_PAGE_ADDR
+  uint8_t col, page;                // Ponteiro de escrita dentro da janela
+  uint8_t cmd[3];                   // Comando multi-byte em montagem
+  uint8_t cmd_len, cmd_need;
+  uint8_t contrast;
+  bool display_on;
+  uint8_t start_line;
+  const uint16_t *dma_words;
+  size_t dma_count;
+  bool dma_active;
+  bool dma_failed;
+  size_t transactions;
+  size_t bytes;
+  uint32_t bus_hz;
+  uint64_t now_us;
+  uint64_t (*clock)(void);        // Relógio externo (NULL: relógio próprio, now_us)
+  void (*wait_us)(uint64_t us);   // Espera no relógio externo (escritas bloqueantes)
+  uint64_t dma_done_us;
+} mock;
+
+// Duração de uma transação de len bytes (sem o endereço) no barramento
+static uint64_t bus_time_us(size_t len) {
+  uint32_t hz = mock.bus_hz ? mock.bus_hz : 400000;
+  return ((len + 1) * 9 + 2) * 1000000ull / hz;
+}
+
+// Quantidade de bytes (comando + argumentos) de cada comando multi-byte
+static uint8_t command_length(uint8_t command) {
+  switch (command) {
+    case SET_HSCROLL_RIGHT:
+    case SET_HSCROLL_LEFT:
+      return 7;
+    case SET_VHSCROLL_RIGHT:
+    case SET_VHSCROLL_LEFT:
+      return 6;
+    case SET_COL_ADDR:
+    case SET_PAGE_ADDR:
+    case SET_VSCROLL_AREA:
+      return 3;
+    case SET_CONTRAST:
+    case SET_MEM_ADDR:
+    case SET_MUX_RATIO:
+    case SET_DISP_OFFSET:
+    case SET_COM_PIN_CFG:
+    case SET_DISP_CLK_DIV:
+    case SET_PRECHARGE:
+    case SET_VCOM_DESEL:
+    case SET_CHARGE_PUMP:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+static void mock_command(uint8_t byte) {
+  if (mock.cmd_len == 0)
+    mock.cmd_need = command_length(byte);
+  mock.cmd[mock.cmd_len++] = byte;
+  if (mock.cmd_len < mock.cmd_need)
+    return;
+  mock.cmd_len = 0;
+  if (mock.cmd[0] == SET_COL_ADDR) {
+    mock.col0 = mock.col = mock.cmd[1] % WIDTH;
+    mock.col1 = mock.cmd[2] % WIDTH;
+  } else if (mock.cmd[0] == SET_PAGE_ADDR) {
+    mock.page0 = mock.page = mock.cmd[1] % SSD1306_MAX_PAGES;
+    mock.page1 = mock.cmd[2] % SSD1306_MAX_PAGES;
+  } else if (mock.cmd[0] == SET_CONTRAST) {
+    mock.contrast = mock.cmd[1];
+  } else if ((mock.cmd[0] & 0xFE) == SET_DISP) {
+    mock.display_on = mock.cmd[0] & 0x01;
+  } else if ((mock.cmd[0] & 0xC0) == SET_DISP_START_LINE) {
+    mock.start_line = mock.cmd[0] & 0x3F;
+  }
+}
+
+static void mock_data(uint8_t byte) {
+  mock.panel[mock.page * WIDTH + mock.col] = byte;
+  if (mock.col++ == mock.col1) {
+    mock.col = mock.col0;
+    mock.page = (mock.page == mock.page1) ? mock.page0 : mock.page + 1;
+  }
+}
+
+// Interpreta uma transação completa (sem o endereço) segundo os bytes de controle
+static void mock_transaction(const uint8_t *bytes, size_t len) {
+  mock.transactions++;
+  mock.bytes += len;
+  if (!mock.clock)
+    mock.now_us += bus_time_us(len);
+  size_t i = 0;
+  while (i < len) {
+    uint8_t control = bytes[i++];
+    bool data = control & 0x40;
+    if (control & 0x80) { // Co = 1: um único byte segue este controle
+      if (i < len)
+        data ? mock_data(bytes[i]) : mock_command(bytes[i]);
+      i++;
+      continue;
+    }
+    for (; i < len; i++) // Co = 0: o restante da transação é do mesmo tipo
+      data ? mock_data(bytes[i]) : mock_command(bytes[i]);
+  }
+}
+
+void ssd1306_hal_write_blocking(ssd1306_t *ssd, const uint8_t *src, size_t len) {
+  (void)ssd;
+  mock_transaction(src, len);
+  if (mock.wait_us)
+    mock.wait_us(bus_time_us(len));
+}
+
+void ssd1306_hal_dma_start(ssd1306_t *ssd, const uint16_t *words, size_t count) {
+  (void)ssd;
+  mock.dma_words = words;
+  mock.dma_count = count;
+  mock.dma_active = true;
+  if (mock.clock) {
+    uint64_t busy = 0;
+    size_t len = 0;
+    for (size_t i = 0; i < count; i++) {
+      len++;
+      if (words[i] & SSD1306_HAL_STOP) {
+        busy += bus_time_us(len);
+        len = 0;
+      }
+    }
+    mock.dma_done_us = mock.clock() + busy;
+  }
+}
+
+ssd1306_hal_status_t ssd1306_hal_dma_poll(ssd1306_t *ssd) {
+  (void)ssd;
+  if (mock.dma_active && mock.clock && mock.clock() >= mock.dma_done_us)
+    ssd1306_hal_mock_complete(true);
+  if (mock.dma_active)
+    return SSD1306_HAL_BUSY;
+  if (mock.dma_failed) {
+    mock.dma_failed = false;
+    return SSD1306_HAL_ERROR;
+  }
+  return SSD1306_HAL_DONE;
+}
+
+void ssd1306_hal_mock_reset(void) {
+  memset(&mock, 0, sizeof(mock));
+  mock.col1 = WIDTH - 1;
+  mock.page1 = SSD1306_MAX_PAGES - 1;
+  mock.contrast = 0x7F; // Valores após o reset do SSD1306
+  mock.bus_hz = 400000;
+}
+
+void ssd1306_hal_mock_set_bus_hz(uint32_t hz) {
+  mock.bus_hz = hz;
+}
+
+// Passa a usar o relógio da simulação; as transferências concluem sozinhas
+void ssd1306_hal_mock_set_clock(uint64_t (*clock)(void), void (*wait_us)(uint64_t us)) {
+  mock.clock = clock;
+  mock.wait_us = wait_us;
+}
+
+uint64_t ssd1306_hal_time_us(void) {
+  return mock.clock ? mock.clock() : mock.now_us;
+}
+
+// Entrega o fluxo da DMA ao painel simulado; com ok = false a transferência é
+// descartada, como em um NACK, e o driver recebe SSD1306_HAL_ERROR
+
+void ssd1306_hal_mock_complete(bool ok) {
+  if (!mock.dma_active)
+    return;
+  if (ok) {
+    uint8_t bytes[SSD1306_MAX_PAGES * (WIDTH + SSD1306_WINDOW_OVERHEAD)];
+    size_t len = 0;
+    for (size_t i = 0; i < mock.dma_count; i++) {
+      bytes[len++] = (uint8_t)mock.dma_words[i];
+      if (mock.dma_words[i] & SSD1306_HAL_STOP) {
+        mock_transaction(bytes, len);
+        len = 0;
+      }
+    }
+  }
+  mock.dma_failed = !ok;
+  mock.dma_active = false;
+}
+
+bool ssd1306_hal_mock_dma_active(void) {
+  return mock.dma_active;
+}
+
+size_t ssd1306_hal_mock_transactions(void) {
+  return mock.transactions;
+}
+
+size_t ssd1306_hal_mock_bytes(void) {
+  return mock.bytes;
+}
+
+const uint8_t *ssd1306_hal_mock_panel(void) {
+  return mock.panel;
+}
+
+bool ssd1306_hal_mock_display_on(void) {
+  return mock.display_on;
+}
+
+uint8_t ssd1306_hal_mock_contrast(void) {
+  return mock.contrast;
+}
+
+uint8_t ssd1306_hal_mock_start_line(void) {
+  return mock.start_line;
+}
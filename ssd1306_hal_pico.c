@@ -0,0 +1,57 @@
+#include "ssd1306_hal.h"
+#include "hardware/dma.h"
+
+// Backend do RP2040: comandos via i2c_write_blocking e quadros via DMA na FIFO de TX.
+// A DMA escreve palavras de 16 bits em IC_DATA_CMD para que o bit STOP de cada
+// transação vá junto com o dado; após um STOP o controlador gera um novo START
+// sozinho, então um quadro com várias janelas é uma única transferência.
+
+void ssd1306_hal_write_blocking(ssd1306_t *ssd, const uint8_t *src, size_t len) {
+  i2c_write_blocking(
+    ssd->i2c_port,
+    ssd->address,
+    src,
+    len,
+    false
+  );
+}
+
+void ssd1306_hal_dma_start(ssd1306_t *ssd, const uint16_t *words, size_t count) {
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  if (ssd->dma_channel < 0)
+    ssd->dma_channel = dma_claim_unused_channel(true);
+
+  // O endereço de destino só pode ser alterado com o controlador desabilitado
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+  hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_channel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(ssd->dma_channel, &c, &hw->data_cmd, words, count, true);
+}
+
+ssd1306_hal_status_t ssd1306_hal_dma_poll(ssd1306_t *ssd) {
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  if (dma_channel_is_busy(ssd->dma_channel))
+    return SSD1306_HAL_BUSY;
+
+  // A DMA termina ao entregar o último byte à FIFO; o envio só acaba com a FIFO
+  // vazia e o controlador parado após o STOP final
+  if (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+    return SSD1306_HAL_BUSY;
+
+  if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+    (void)hw->clr_tx_abrt; // A leitura limpa o abort e libera a FIFO
+    return SSD1306_HAL_ERROR;
+  }
+  return SSD1306_HAL_DONE;
+}
+
+uint64_t ssd1306_hal_time_us(void) {
+  return time_us_64();
+}
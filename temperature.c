@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include "temperature.h"
+#include "hardware/sync.h"
+
+#define SECONDS_PER_MINUTE 60
+#define MINUTES_PER_HOUR 60
+
+// Retas para a soma de 16 amostras de 12 bits (0..65520), com Vref = 3,3 V:
+//   interno: T = 27 - (V - 0,706) / 0,001721   (datasheet do RP2040)
+//   LM35:    T = V / 0,010
+static const temperature_sensor_t sensors[] = {
+    {"interno", ADC_CHANNEL_TEMPERATURE, 43723, -11984},
+#ifdef TEMPERATURE_EXT_CHANNEL
+    {"externo", TEMPERATURE_EXT_CHANNEL, 0, 2063},
+#endif
+};
+
+#define NUM_SENSORS (sizeof(sensors) / sizeof(sensors[0]))
+
+// Agregado em andamento
+typedef struct {
+    int32_t sum;
+    int16_t min_cc;
+    int16_t max_cc;
+    uint16_t count;
+} running_t;
+
+typedef struct {
+    temperature_aggregate_t *items;
+    uint8_t size;
+    uint8_t head;   // Próxima posição a escrever
+    uint8_t count;
+} history_t;
+
+typedef struct {
+    uint32_t window_sum;   // Soma das janelas do segundo em andamento
+    int16_t current_cc;
+    bool valid;
+    running_t minute_run, hour_run;
+    temperature_aggregate_t minute_items[TEMPERATURE_MINUTES];
+    temperature_aggregate_t hour_items[TEMPERATURE_HOURS];
+    history_t minutes, hours;
+} sensor_state_t;
+
+static sensor_state_t state[NUM_SENSORS];
+static uint windows;
+static repeating_timer_t sample_timer;
+
+static void running_add(running_t *r, int16_t cc) {
+    if (r->count == 0 || cc < r->min_cc)
+        r->min_cc = cc;
+    if (r->count == 0 || cc > r->max_cc)
+        r->max_cc = cc;
+    r->sum += cc;
+    r->count++;
+}
+
+static temperature_aggregate_t running_aggregate(const running_t *r) {
+    return (temperature_aggregate_t){r->min_cc, r->max_cc, (int16_t)(r->sum / r->count)};
+}
+
+static void history_push(history_t *h, running_t *r) {
+    h->items[h->head] = running_aggregate(r);
+    h->head = (h->head + 1) % h->size;
+    if (h->count < h->size)
+        h->count++;
+    *r = (running_t){0};
+}
+
+// Um valor por segundo: o divisor de hardware só é usado ao fechar um minuto
+static void record_second(sensor_state_t *s, int16_t cc) {
+    s->current_cc = cc;
+    s->valid = true;
+    running_add(&s->minute_run, cc);
+    running_add(&s->hour_run, cc);
+    if (s->minute_run.count == SECONDS_PER_MINUTE) {
+        history_push(&s->minutes, &s->minute_run);
+        if (s->hour_run.count == SECONDS_PER_MINUTE * MINUTES_PER_HOUR)
+            history_push(&s->hours, &s->hour_run);
+    }
+}
+
+// Interrupção do timer: soma a janela mais recente de cada sensor; a cada
+// 2^TEMPERATURE_WINDOWS_LOG2 janelas, converte a média e registra o segundo
+static bool sample_timer_callback(repeating_timer_t *rt) {
+    (void)rt;
+    for (uint i = 0; i < NUM_SENSORS; i++) {
+        uint32_t count, stride, sum = 0;
+        const uint16_t *samples = adc_stream_samples(sensors[i].adc_channel, &count, &stride);
+        for (uint32_t j = 0; j < count; j++)
+            sum += samples[j * stride];
+        state[i].window_sum += sum;
+    }
+    if (++windows < (1u << TEMPERATURE_WINDOWS_LOG2))
+        return true;
+    windows = 0;
+
+    for (uint i = 0; i < NUM_SENSORS; i++) {
+        sensor_state_t *s = &state[i];
+        int32_t raw = (int32_t)(s->window_sum >> TEMPERATURE_WINDOWS_LOG2);
+        s->window_sum = 0;
+        record_second(s, (int16_t)(sensors[i].offset_cc + ((raw * sensors[i].gain_q12) >> 12)));
+    }
+    return true;
+}
+
+void temperature_init(void) {
+    for (uint i = 0; i < NUM_SENSORS; i++) {
+        state[i].minutes = (history_t){state[i].minute_items, TEMPERATURE_MINUTES, 0, 0};
+        state[i].hours = (history_t){state[i].hour_items, TEMPERATURE_HOURS, 0, 0};
+    }
+    // Período negativo: intervalo entre inícios de callback, independente da duração
+    add_repeating_timer_us(-TEMPERATURE_WINDOW_US, sample_timer_callback, NULL, &sample_timer);
+}
+
+uint temperature_sensor_count(void) {
+    return NUM_SENSORS;
+}
+
+const char *temperature_sensor_name(uint sensor) {
+    return sensor < NUM_SENSORS ? sensors[sensor].name : NULL;
+}
+
+// As leituras mascaram as interrupções: o timer atualiza o estado no mesmo núcleo
+bool temperature_current(uint sensor, int16_t *cc) {
+    if (sensor >= NUM_SENSORS)
+        return false;
+    uint32_t irq = save_and_disable_interrupts();
+    bool valid = state[sensor].valid;
+    *cc = state[sensor].current_cc;
+    restore_interrupts(irq);
+    return valid;
+}
+
+uint temperature_history(uint sensor, temperature_scale_t scale, temperature_aggregate_t *out, uint max) {
+    if (sensor >= NUM_SENSORS || max == 0)
+        return 0;
+    const sensor_state_t *s = &state[sensor];
+    const history_t *h = scale == TEMPERATURE_HOUR ? &s->hours : &s->minutes;
+    const running_t *r = scale == TEMPERATURE_HOUR ? &s->hour_run : &s->minute_run;
+
+    uint32_t irq = save_and_disable_interrupts();
+    uint copied = 0;
+    uint done = r->count ? max - 1 : max; // Reserva a última posição para o período em andamento
+    uint skip = h->count > done ? h->count - done : 0;
+    for (uint i = skip; i < h->count; i++)
+        out[copied++] = h->items[(h->head + h->size - h->count + i) % h->size];
+    if (r->count)
+        out[copied++] = running_aggregate(r);
+    restore_interrupts(irq);
+    return copied;
+}
+
+void temperature_format(int16_t cc, char *buf, size_t size) {
+    int32_t v = cc < 0 ? -(int32_t)cc : cc;
+    int32_t tenths = (v + 5) / 10;
+    snprintf(buf, size, "%s%ld.%ld", cc < 0 ? "-" : "", (long)(tenths / 10), (long)(tenths % 10));
+}
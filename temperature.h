@@ -0,0 +1,63 @@
+#ifndef TEMPERATURE_H
+#define TEMPERATURE_H
+
+// Aquisição de temperatura em segundo plano: um timer soma as janelas do anel
+// do ADC (adc_stream.h) de cada sensor (sobreamostragem) e, a cada segundo,
+// converte a média em centésimos de grau com uma reta em ponto fixo (sem float:
+// o M0+ não tem FPU). Os valores de cada segundo alimentam anéis compactos de
+// agregados (mínimo, máximo e média) por minuto e por hora.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "adc_stream.h"
+
+#define TEMPERATURE_WINDOW_US 15625     // Uma janela do anel (16 amostras a 1 kHz) por disparo
+#define TEMPERATURE_WINDOWS_LOG2 6      // 64 janelas = 1 s por valor
+#define TEMPERATURE_MINUTES 60          // Agregados por minuto guardados (1 h)
+#define TEMPERATURE_HOURS 24            // Agregados por hora guardados (1 dia)
+
+// Sensor externo opcional (ex.: LM35 no GPIO28, canal 2 do ADC): defina
+// TEMPERATURE_EXT_CHANNEL na compilação para adicioná-lo à aquisição
+#ifdef TEMPERATURE_EXT_CHANNEL
+#define TEMPERATURE_ADC_CHANNELS ((1u << ADC_CHANNEL_TEMPERATURE) | (1u << TEMPERATURE_EXT_CHANNEL))
+#else
+#define TEMPERATURE_ADC_CHANNELS (1u << ADC_CHANNEL_TEMPERATURE)
+#endif
+
+// Reta de conversão: centésimos de °C = offset_cc + (soma de 16 amostras * gain_q12) >> 12
+typedef struct {
+    const char *name;
+    uint8_t adc_channel;
+    int32_t offset_cc;
+    int32_t gain_q12;
+} temperature_sensor_t;
+
+typedef enum {
+    TEMPERATURE_MINUTE,
+    TEMPERATURE_HOUR
+} temperature_scale_t;
+
+typedef struct {
+    int16_t min_cc;
+    int16_t max_cc;
+    int16_t mean_cc;
+} temperature_aggregate_t;
+
+// Requer os canais de TEMPERATURE_ADC_CHANNELS habilitados no adc_stream
+void temperature_init(void);
+
+uint temperature_sensor_count(void);
+const char *temperature_sensor_name(uint sensor);
+
+// Valor do último segundo completo; false antes do primeiro
+bool temperature_current(uint sensor, int16_t *cc);
+
+// Copia até max agregados, do mais antigo ao mais recente; o último é o
+// período em andamento. Retorna quantos foram copiados.
+uint temperature_history(uint sensor, temperature_scale_t scale, temperature_aggregate_t *out, uint max);
+
+// "-12.3": centésimos de grau com uma casa decimal
+void temperature_format(int16_t cc, char *buf, size_t size);
+
+#endif // TEMPERATURE_H
@@ -0,0 +1,38 @@
+#ifndef TEST_H
+#define TEST_H
+
+// Verificações dos testes do host (registrados no ctest pelo CMakeLists.txt):
+// cada CHECK que falha imprime a condição e continua; test_result encerra o
+// teste com código 1 se alguma falhou.
+#include <stdio.h>
+
+static int test_failures;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond);   \
+            test_failures++;                                                     \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                               \
+    do {                                                                         \
+        long long a_ = (long long)(actual), e_ = (long long)(expected);          \
+        if (a_ != e_) {                                                          \
+            fprintf(stderr, "%s:%d: falhou: %s == %s (%lld != %lld)\n", __FILE__, \
+                    __LINE__, #actual, #expected, a_, e_);                       \
+            test_failures++;                                                     \
+        }                                                                        \
+    } while (0)
+
+static inline int test_result(const char *name) {
+    if (test_failures) {
+        fprintf(stderr, "%s: %d verificação(ões) falharam\n", name, test_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+#endif // TEST_H
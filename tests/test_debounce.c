@@ -0,0 +1,152 @@
+#include "debounce.h"
+#include "test.h"
+
+// Contadores verticais do debounce: bordas só depois de DEBOUNCE_SAMPLES
+// amostras seguidas, entradas independentes e pressionamento longo
+
+#define IN_A 0
+#define IN_B 5
+#define IN_LONG 31
+
+static debounce_t d;
+static debounce_edges_t edges;
+static uint32_t now_us;
+
+// Uma amostra por milissegundo
+static void sample(uint32_t levels, uint32_t active) {
+    now_us += 1000;
+    debounce_update(&d, levels, active, now_us, &edges);
+}
+
+static void test_press_after_four_samples(void) {
+    debounce_init(&d);
+    now_us = 0;
+    for (int i = 0; i < DEBOUNCE_SAMPLES - 1; i++) {
+        sample(1u << IN_A, ~0u);
+        CHECK_EQ(edges.pressed, 0);
+        CHECK(!debounce_active(&d, IN_A));
+    }
+    sample(1u << IN_A, ~0u);
+    CHECK_EQ(edges.pressed, 1u << IN_A);
+    CHECK(debounce_active(&d, IN_A));
+
+    // Mantida: nenhuma borda nova
+    sample(1u << IN_A, ~0u);
+    CHECK_EQ(edges.pressed, 0);
+
+    for (int i = 0; i < DEBOUNCE_SAMPLES - 1; i++) {
+        sample(0, ~0u);
+        CHECK_EQ(edges.released, 0);
+    }
+    sample(0, ~0u);
+    CHECK_EQ(edges.released, 1u << IN_A);
+    CHECK(!debounce_active(&d, IN_A));
+}
+
+// Um repique (amostra igual ao estado aceito) zera o contador
+static void test_bounce_restarts_count(void) {
+    debounce_init(&d);
+    now_us = 0;
+    for (int i = 0; i < DEBOUNCE_SAMPLES - 1; i++)
+        sample(1u << IN_A, ~0u);
+    sample(0, ~0u);
+    for (int i = 0; i < DEBOUNCE_SAMPLES - 1; i++) {
+        sample(1u << IN_A, ~0u);
+        CHECK_EQ(edges.pressed, 0);
+    }
+    sample(1u << IN_A, ~0u);
+    CHECK_EQ(edges.pressed, 1u << IN_A);
+}
+
+// Entradas contam em paralelo, cada uma com o seu contador
+static void test_inputs_are_independent(void) {
+    debounce_init(&d);
+    now_us = 0;
+    sample(1u << IN_A, ~0u);
+    sample(1u << IN_A, ~0u);
+    sample((1u << IN_A) | (1u << IN_B), ~0u);
+    sample((1u << IN_A) | (1u << IN_B), ~0u);
+    CHECK_EQ(edges.pressed, 1u << IN_A);
+    sample((1u << IN_A) | (1u << IN_B), ~0u);
+    sample((1u << IN_A) | (1u << IN_B), ~0u);
+    CHECK_EQ(edges.pressed, 1u << IN_B);
+    CHECK_EQ(d.state, (1u << IN_A) | (1u << IN_B));
+}
+
+// Entradas fora de active mantêm contador e estado (grupos amostrados em ticks diferentes)
+static void test_inactive_inputs_keep_count(void) {
+    debounce_init(&d);
+    now_us = 0;
+    uint32_t a = 1u << IN_A, b = 1u << IN_B;
+    sample(a | b, a | b);
+    sample(a | b, a | b);
+    sample(a | b, a);           // B não é amostrada: segue com 2
+    sample(a | b, a);
+    CHECK_EQ(edges.pressed, a);
+    sample(b, b);               // A não é amostrada mesmo com o nível em 0
+    CHECK(debounce_active(&d, IN_A));
+    CHECK_EQ(edges.pressed, 0);
+    sample(b, b);
+    CHECK_EQ(edges.pressed, b);
+}
+
+// Pressionamento longo: sinalizado uma vez ao atingir long_us; soltar antes é
+// um toque curto, soltar depois não
+static void test_long_press(void) {
+    uint32_t bit = 1u << IN_LONG;
+    debounce_init(&d);
+    debounce_set_long_press(&d, IN_LONG, 800000);
+    now_us = 0;
+
+    for (int i = 0; i < DEBOUNCE_SAMPLES; i++)
+        sample(bit, ~0u);
+    CHECK_EQ(edges.pressed, bit);
+    uint32_t pressed_us = now_us;
+    int long_count = 0;
+    while (now_us - pressed_us < 900000) {
+        sample(bit, ~0u);
+        if (edges.long_pressed) {
+            CHECK_EQ(edges.long_pressed, bit);
+            CHECK_EQ(now_us - pressed_us, 800000);
+            long_count++;
+        }
+    }
+    CHECK_EQ(long_count, 1);
+    for (int i = 0; i < DEBOUNCE_SAMPLES; i++)
+        sample(0, ~0u);
+    CHECK_EQ(edges.released, bit);
+    CHECK_EQ(edges.short_released, 0);
+
+    // Toque curto
+    for (int i = 0; i < DEBOUNCE_SAMPLES; i++)
+        sample(bit, ~0u);
+    for (int i = 0; i < 100; i++)
+        sample(bit, ~0u);
+    CHECK_EQ(edges.long_pressed, 0);
+    for (int i = 0; i < DEBOUNCE_SAMPLES; i++)
+        sample(0, ~0u);
+    CHECK_EQ(edges.released, bit);
+    CHECK_EQ(edges.short_released, bit);
+
+    // Sem long_us configurado, não há toque curto nem longo
+    debounce_set_long_press(&d, IN_LONG, 0);
+    for (int i = 0; i < DEBOUNCE_SAMPLES; i++)
+        sample(bit, ~0u);
+    for (int i = 0; i < 1000; i++) {
+        sample(bit, ~0u);
+        CHECK_EQ(edges.long_pressed, 0);
+    }
+    for (int i = 0; i < DEBOUNCE_SAMPLES; i++)
+        sample(0, ~0u);
+    CHECK_EQ(edges.released, bit);
+    CHECK_EQ(edges.short_released, 0);
+}
+
+int main(void) {
+    test_press_after_four_samples();
+    test_bounce_restarts_count();
+    test_inputs_are_independent();
+    test_inactive_inputs_keep_count();
+    test_long_press();
+    return test_result("debounce");
+}
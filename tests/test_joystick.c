@@ -0,0 +1,98 @@
+#include "joystick.h"
+#include "test.h"
+
+// Filtro, zona morta com histerese e repetição acelerada do joystick (funções puras)
+
+#define CENTER 2048
+
+// Média móvel: cada amostra anda 1/4 da distância em Q4
+static void test_filter_step(void) {
+    joystick_axis_t axis;
+    joystick_axis_init(&axis, CENTER);
+    CHECK_EQ(joystick_filter(&axis, CENTER), 0);
+
+    CHECK_EQ(joystick_filter(&axis, CENTER + 1600), 400);
+    CHECK_EQ(joystick_filter(&axis, CENTER + 1600), 700);
+    CHECK_EQ(joystick_filter(&axis, CENTER + 1600), 925);
+    for (int i = 0; i < 100; i++)
+        joystick_filter(&axis, CENTER + 1600);
+    CHECK(axis.filtered <= (int32_t)(CENTER + 1600) << JOYSTICK_FILTER_FRAC);
+    CHECK(joystick_filter(&axis, CENTER + 1600) >= 1599);
+
+    // Abaixo do centro o desvio é negativo e simétrico
+    joystick_axis_init(&axis, CENTER);
+    CHECK_EQ(joystick_filter(&axis, CENTER - 1600), -400);
+    CHECK_EQ(joystick_filter(&axis, CENTER - 1600), -700);
+}
+
+// Entra acima de JOYSTICK_ENTER (1000) e só sai abaixo de JOYSTICK_EXIT (600)
+static void test_direction_hysteresis(void) {
+    joystick_axis_t axis;
+    joystick_axis_init(&axis, CENTER);
+
+    CHECK_EQ(joystick_direction(&axis, 999), 0);
+    CHECK_EQ(joystick_direction(&axis, 1000), 0);
+    CHECK_EQ(joystick_direction(&axis, 1001), 1);
+    CHECK_EQ(joystick_direction(&axis, 800), 1);
+    CHECK_EQ(joystick_direction(&axis, 600), 1);
+    CHECK_EQ(joystick_direction(&axis, 599), 0);
+    CHECK_EQ(joystick_direction(&axis, 800), 0);
+
+    CHECK_EQ(joystick_direction(&axis, -1001), -1);
+    CHECK_EQ(joystick_direction(&axis, -600), -1);
+    // Inversão direta sem passar pelo centro
+    CHECK_EQ(joystick_direction(&axis, 1200), 1);
+    // Do outro lado, mas sem chegar a JOYSTICK_ENTER: volta ao centro
+    CHECK_EQ(joystick_direction(&axis, -700), 0);
+}
+
+// Passos emitidos com o eixo inclinado de start_us a end_us, amostrado a cada 1 us
+static int collect_steps(joystick_repeat_t *repeat, uint32_t start_us, uint32_t end_us, uint32_t *steps,
+                         int max) {
+    int n = 0;
+    for (uint32_t t = start_us; t != end_us; t++)
+        if (joystick_repeat_step(repeat, 1, t) && n < max)
+            steps[n++] = t;
+    return n;
+}
+
+// Um passo ao inclinar, o segundo após 400 ms, o terceiro após 200 ms, e os
+// intervalos encurtam 1/4 por repetição até 60 ms
+static void test_repeat_acceleration(void) {
+    static const uint32_t gaps[] = {400000, 200000, 150000, 112500, 84375, 63282, 60000, 60000};
+    joystick_repeat_t repeat = {0};
+    uint32_t steps[16];
+
+    int n = collect_steps(&repeat, 0, 1200000, steps, 16);
+    CHECK(n >= (int)(sizeof(gaps) / sizeof(gaps[0])) + 1);
+    CHECK_EQ(steps[0], 0);
+    for (int i = 0; i < (int)(sizeof(gaps) / sizeof(gaps[0])) && i + 1 < n; i++)
+        CHECK_EQ(steps[i + 1] - steps[i], gaps[i]);
+
+    // Soltar e inclinar de novo recomeça do passo imediato com o atraso inicial
+    CHECK(!joystick_repeat_step(&repeat, 0, 1300000));
+    CHECK(joystick_repeat_step(&repeat, 1, 1300001));
+    CHECK(!joystick_repeat_step(&repeat, 1, 1300001 + JOYSTICK_REPEAT_DELAY_US - 1));
+    CHECK(joystick_repeat_step(&repeat, 1, 1300001 + JOYSTICK_REPEAT_DELAY_US));
+
+    // Inverter a direção também é um passo imediato
+    CHECK(joystick_repeat_step(&repeat, -1, 1800000));
+}
+
+// O relógio de 32 bits dá a volta a cada ~71 minutos
+static void test_repeat_wraparound(void) {
+    joystick_repeat_t repeat = {0};
+    uint32_t start = UINT32_MAX - 100000;
+    uint32_t steps[4];
+    int n = collect_steps(&repeat, start, start + JOYSTICK_REPEAT_DELAY_US + 1, steps, 4);
+    CHECK_EQ(n, 2);
+    CHECK_EQ(steps[1] - steps[0], JOYSTICK_REPEAT_DELAY_US);
+}
+
+int main(void) {
+    test_filter_step();
+    test_direction_hysteresis();
+    test_repeat_acceleration();
+    test_repeat_wraparound();
+    return test_result("joystick");
+}
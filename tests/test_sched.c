@@ -0,0 +1,170 @@
+#include "sim.h"
+#include "sched.h"
+#include "test.h"
+
+// Agendador por prazos sobre o relógio simulado. sched_after lê time_us_32 (que
+// avança 1 us por leitura); o prazo é calculado a partir de sim_now_us logo
+// depois, e sched_tick recebe instantes explícitos.
+
+static int calls[4];
+
+static void count_call(void *arg) {
+    calls[(int)(intptr_t)arg]++;
+}
+
+static void reset(void) {
+    sim_init();
+    for (int i = 0; i < 4; i++)
+        calls[i] = 0;
+    // Esvazia a tabela deixada pelo teste anterior
+    for (int slot = 0; slot < SCHED_MAX_TASKS; slot++)
+        for (int generation = 0; generation < 256; generation++)
+            sched_cancel(slot | generation << 8);
+}
+
+static int after(uint32_t delay_us, uint32_t period_us, int counter, uint32_t *deadline_us) {
+    int id = sched_after(delay_us, period_us, count_call, (void *)(intptr_t)counter);
+    *deadline_us = (uint32_t)sim_now_us() + delay_us;
+    return id;
+}
+
+// Disparo único: não antes do prazo, uma vez só, e a posição é liberada
+static void test_one_shot(void) {
+    reset();
+    uint32_t deadline;
+    int id = after(1000, 0, 0, &deadline);
+    CHECK(id != SCHED_INVALID);
+    CHECK(sched_pending(id));
+
+    sched_tick(deadline - 1);
+    CHECK_EQ(calls[0], 0);
+    sched_tick(deadline);
+    CHECK_EQ(calls[0], 1);
+    CHECK(!sched_pending(id));
+    sched_tick(deadline + 5000);
+    CHECK_EQ(calls[0], 1);
+}
+
+// Periódica: um disparo por período e, depois de um atraso longo, um único
+// disparo sem rajada de recuperação, com a fase recomeçando no instante atrasado
+static void test_periodic(void) {
+    reset();
+    uint32_t deadline;
+    int id = after(100, 1000, 0, &deadline);
+
+    sched_tick(deadline);
+    sched_tick(deadline + 999);
+    CHECK_EQ(calls[0], 1);
+    sched_tick(deadline + 1000);
+    CHECK_EQ(calls[0], 2);
+    sched_tick(deadline + 2000);
+    CHECK_EQ(calls[0], 3);
+
+    uint32_t late = deadline + 10500;
+    sched_tick(late);
+    CHECK_EQ(calls[0], 4);
+    sched_tick(late + 999);
+    CHECK_EQ(calls[0], 4);
+    sched_tick(late + 1000);
+    CHECK_EQ(calls[0], 5);
+    CHECK(sched_pending(id));
+
+    sched_cancel(id);
+    CHECK(!sched_pending(id));
+    sched_tick(late + 5000);
+    CHECK_EQ(calls[0], 5);
+}
+
+// Adiar move o prazo a partir de agora
+static void test_postpone(void) {
+    reset();
+    uint32_t deadline;
+    int id = after(1000, 0, 0, &deadline);
+    sim_run_for_us(500);
+    sched_postpone(id, 1000);
+    uint32_t postponed = (uint32_t)sim_now_us() + 1000;
+
+    sched_tick(deadline);
+    CHECK_EQ(calls[0], 0);
+    sched_tick(postponed);
+    CHECK_EQ(calls[0], 1);
+}
+
+// Um identificador antigo não afeta a tarefa que reutiliza a posição
+static void test_stale_id(void) {
+    reset();
+    uint32_t deadline;
+    int old = after(100, 0, 0, &deadline);
+    sched_tick(deadline);
+    CHECK_EQ(calls[0], 1);
+
+    int reused = after(100, 0, 1, &deadline);
+    CHECK_EQ(reused & 0xFF, old & 0xFF);
+    CHECK(reused != old);
+    CHECK(!sched_pending(old));
+    sched_cancel(old);
+    sched_postpone(old, 100000);
+    CHECK(sched_pending(reused));
+    sched_tick(deadline);
+    CHECK_EQ(calls[1], 1);
+}
+
+// Tabela cheia
+static void test_full_table(void) {
+    reset();
+    uint32_t deadline;
+    for (int i = 0; i < SCHED_MAX_TASKS; i++)
+        CHECK(after(1000, 0, 0, &deadline) != SCHED_INVALID);
+    CHECK_EQ(after(1000, 0, 0, &deadline), SCHED_INVALID);
+    sched_tick(deadline);
+    CHECK_EQ(calls[0], SCHED_MAX_TASKS);
+    CHECK(after(1000, 0, 0, &deadline) != SCHED_INVALID);
+}
+
+// A tarefa de disparo único é liberada antes da chamada: pode se reagendar
+static int rescheduled_id = SCHED_INVALID;
+
+static void reschedule(void *arg) {
+    (void)arg;
+    calls[2]++;
+    rescheduled_id = sched_after(1000, 0, count_call, (void *)(intptr_t)3);
+}
+
+static void test_reschedule_from_callback(void) {
+    reset();
+    int id = sched_after(100, 0, reschedule, NULL);
+    uint32_t deadline = (uint32_t)sim_now_us() + 100;
+    sched_tick(deadline);
+    CHECK_EQ(calls[2], 1);
+    CHECK(rescheduled_id != SCHED_INVALID);
+    CHECK((rescheduled_id & 0xFF) == (id & 0xFF));
+    CHECK(sched_pending(rescheduled_id));
+    sched_tick((uint32_t)sim_now_us() + 1000);
+    CHECK_EQ(calls[3], 1);
+}
+
+// Prazos que cruzam a volta do relógio de 32 bits
+static void test_wraparound(void) {
+    reset();
+    sim_run_for_us(UINT32_MAX - 500);
+    uint32_t deadline;
+    after(1000, 1000, 0, &deadline);
+    CHECK(deadline < 1000);
+    sched_tick(deadline - 1);
+    CHECK_EQ(calls[0], 0);
+    sched_tick(deadline);
+    CHECK_EQ(calls[0], 1);
+    sched_tick(deadline + 1000);
+    CHECK_EQ(calls[0], 2);
+}
+
+int main(void) {
+    test_one_shot();
+    test_periodic();
+    test_postpone();
+    test_stale_id();
+    test_full_table();
+    test_reschedule_from_callback();
+    test_wraparound();
+    return test_result("sched");
+}
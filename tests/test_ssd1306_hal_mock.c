@@ -0,0 +1,150 @@
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_hal.h"
+#include "test.h"
+
+// Máquina de estados do envio assíncrono sobre o backend simulado, sem relógio
+// externo: cada DMA só termina quando o teste chama ssd1306_hal_mock_complete.
+
+#define PAGE_BYTES (WIDTH * HEIGHT / 8)
+
+static ssd1306_t ssd;
+static int flushes_done;
+
+static void on_flush_done(ssd1306_t *s, void *ctx) {
+    (void)s;
+    (void)ctx;
+    flushes_done++;
+}
+
+static bool panel_pixel(int x, int y) {
+    return (ssd1306_hal_mock_panel()[(y / 8) * WIDTH + x] >> (y % 8)) & 1u;
+}
+
+static bool panel_matches_back_buffer(void) {
+    return memcmp(ssd1306_hal_mock_panel(), &ssd.ram_buffer[1], PAGE_BYTES) == 0;
+}
+
+static void setup(void) {
+    ssd1306_hal_mock_reset();
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+    ssd1306_config(&ssd);
+    ssd1306_set_flush_callback(&ssd, on_flush_done, NULL);
+    flushes_done = 0;
+
+    // Primeiro quadro: completo, chega ao painel quando a DMA termina
+    ssd1306_fill(&ssd, false);
+    ssd1306_swap(&ssd);
+    CHECK(ssd1306_flush_start(&ssd));
+    CHECK(ssd1306_hal_mock_dma_active());
+    CHECK(ssd1306_flush_poll(&ssd));
+    ssd1306_hal_mock_complete(true);
+    CHECK(!ssd1306_flush_poll(&ssd));
+    CHECK_EQ(flushes_done, 1);
+    CHECK(panel_matches_back_buffer());
+}
+
+// Quadro publicado durante um envio: fica enfileirado e parte quando o atual termina
+static void test_swap_while_busy(void) {
+    setup();
+    uint32_t started = ssd.frames_started;
+
+    ssd1306_pixel(&ssd, 10, 10, true);
+    ssd1306_swap(&ssd);
+    CHECK(ssd1306_flush_start(&ssd));
+    CHECK_EQ(ssd.frames_started, started + 1);
+
+    ssd1306_pixel(&ssd, 100, 50, true);
+    ssd1306_swap(&ssd);
+    CHECK(!ssd1306_flush_start(&ssd));
+    CHECK(ssd.frame_queued);
+    CHECK_EQ(ssd.frames_started, started + 1);
+    CHECK(!panel_pixel(10, 10));
+
+    // O primeiro quadro conclui e o enfileirado começa no mesmo poll
+    ssd1306_hal_mock_complete(true);
+    CHECK(ssd1306_flush_poll(&ssd));
+    CHECK_EQ(flushes_done, 2);
+    CHECK(!ssd.frame_queued);
+    CHECK_EQ(ssd.frames_started, started + 2);
+    CHECK(ssd1306_hal_mock_dma_active());
+    CHECK(panel_pixel(10, 10));
+    CHECK(!panel_pixel(100, 50));
+    // Só a coluna alterada depois do primeiro swap segue no quadro enfileirado
+    CHECK(ssd.bytes_sent < SSD1306_WINDOW_OVERHEAD + 2);
+
+    ssd1306_hal_mock_complete(true);
+    CHECK(!ssd1306_flush_poll(&ssd));
+    CHECK_EQ(flushes_done, 3);
+    CHECK(panel_pixel(100, 50));
+    CHECK(panel_matches_back_buffer());
+}
+
+// Publicar de novo sem mudanças não gera tráfego
+static void test_idle_frame(void) {
+    setup();
+    ssd1306_swap(&ssd);
+    CHECK(!ssd1306_flush_start(&ssd));
+    CHECK(!ssd1306_hal_mock_dma_active());
+    CHECK_EQ(ssd.bytes_sent, 0);
+}
+
+// Envio abortado: o painel fica incerto, então o próximo quadro é completo e
+// reenvia a linha inicial
+static void test_error_invalidates(void) {
+    setup();
+
+    ssd1306_pixel(&ssd, 20, 30, true);
+    ssd1306_set_start_line(&ssd, 8);
+    ssd1306_swap(&ssd);
+    CHECK(ssd1306_flush_start(&ssd));
+    ssd1306_hal_mock_complete(false);
+    CHECK(!ssd1306_flush_poll(&ssd));
+    CHECK_EQ(flushes_done, 2);
+    CHECK(!panel_pixel(20, 30));
+    CHECK_EQ(ssd1306_hal_mock_start_line(), 0);
+    for (int page = 0; page < HEIGHT / 8; page++) {
+        CHECK_EQ(ssd.pending_x0[page], 0);
+        CHECK_EQ(ssd.pending_x1[page], WIDTH - 1);
+    }
+    CHECK_EQ(ssd.panel_start_line, 0xFF);
+
+    // Sem nenhuma mudança no back buffer, o quadro seguinte reenvia tudo
+    ssd1306_swap(&ssd);
+    CHECK(ssd1306_flush_start(&ssd));
+    CHECK(ssd.bytes_sent >= PAGE_BYTES);
+    ssd1306_hal_mock_complete(true);
+    CHECK(!ssd1306_flush_poll(&ssd));
+    CHECK(panel_pixel(20, 30));
+    CHECK(panel_matches_back_buffer());
+    CHECK_EQ(ssd1306_hal_mock_start_line(), 8);
+}
+
+// Erro com um quadro enfileirado: o enfileirado parte já com o quadro completo
+static void test_error_with_queued_frame(void) {
+    setup();
+
+    ssd1306_pixel(&ssd, 1, 1, true);
+    ssd1306_swap(&ssd);
+    CHECK(ssd1306_flush_start(&ssd));
+    ssd1306_pixel(&ssd, 2, 2, true);
+    ssd1306_swap(&ssd);
+    CHECK(!ssd1306_flush_start(&ssd));
+
+    ssd1306_hal_mock_complete(false);
+    CHECK(ssd1306_flush_poll(&ssd));
+    CHECK(ssd.bytes_sent >= PAGE_BYTES);
+    ssd1306_hal_mock_complete(true);
+    CHECK(!ssd1306_flush_poll(&ssd));
+    CHECK(panel_pixel(1, 1));
+    CHECK(panel_pixel(2, 2));
+    CHECK(panel_matches_back_buffer());
+}
+
+int main(void) {
+    test_swap_while_busy();
+    test_idle_frame();
+    test_error_invalidates();
+    test_error_with_queued_frame();
+    return test_result("ssd1306_hal_mock");
+}
@@ -0,0 +1,98 @@
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "adc_stream.h"
+#include "temperature.h"
+#include "test.h"
+
+// Conversão do sensor interno em ponto fixo contra a fórmula do datasheet do
+// RP2040, agregados por minuto e formatação. A aquisição roda de verdade sobre
+// o ADC e a DMA simulados: o canal 4 devolve sempre o valor de sim_adc_set.
+
+#define ADC_VREF 3.3
+#define TOLERANCE_CC 3  // A reta em Q12 e o arredondamento para baixo custam até ~2 cc
+
+// T = 27 - (V - 0,706) / 0,001721, em centésimos de grau
+static int expected_cc(uint16_t raw) {
+    double volts = raw * ADC_VREF / 4096.0;
+    double celsius = 27.0 - (volts - 0.706) / 0.001721;
+    return (int)(celsius * 100.0 + (celsius < 0 ? -0.5 : 0.5));
+}
+
+static void run_seconds(uint seconds) {
+    sim_run_for_us((uint64_t)seconds * 1000000u + TEMPERATURE_WINDOW_US);
+}
+
+static void test_conversion(void) {
+    static const uint16_t raws[] = {876, 700, 800, 891, 950, 1000, 1200};
+    int16_t cc;
+    CHECK(!temperature_current(0, &cc));
+
+    for (uint i = 0; i < sizeof(raws) / sizeof(raws[0]); i++) {
+        sim_adc_set(ADC_CHANNEL_TEMPERATURE, raws[i]);
+        run_seconds(2); // O segundo em andamento ainda mistura o valor anterior
+        CHECK(temperature_current(0, &cc));
+        int diff = abs(cc - expected_cc(raws[i]));
+        if (diff > TOLERANCE_CC)
+            fprintf(stderr, "raw %u: %d cc, esperado %d cc\n", raws[i], cc, expected_cc(raws[i]));
+        CHECK(diff <= TOLERANCE_CC);
+    }
+}
+
+// Um minuto com dois valores: o agregado fechado guarda mínimo, máximo e média
+static void test_minute_aggregate(void) {
+    temperature_aggregate_t history[TEMPERATURE_MINUTES];
+    uint n = temperature_history(0, TEMPERATURE_MINUTE, history, TEMPERATURE_MINUTES);
+    CHECK(n >= 1);
+
+    // Completa o minuto em andamento e começa outro só com 876 e 950
+    sim_adc_set(ADC_CHANNEL_TEMPERATURE, 876);
+    run_seconds(60);
+    int16_t low, high;
+    CHECK(temperature_current(0, &high));
+    sim_adc_set(ADC_CHANNEL_TEMPERATURE, 950);
+    run_seconds(60);
+    CHECK(temperature_current(0, &low));
+
+    n = temperature_history(0, TEMPERATURE_MINUTE, history, TEMPERATURE_MINUTES);
+    CHECK(n >= 3);
+    const temperature_aggregate_t *last_full = &history[n - 2];
+    CHECK(last_full->min_cc >= low);
+    CHECK(last_full->max_cc <= high);
+    CHECK(last_full->min_cc <= last_full->mean_cc && last_full->mean_cc <= last_full->max_cc);
+
+    // max limita quantos agregados saem, sempre terminando no período em andamento
+    temperature_aggregate_t two[2];
+    CHECK_EQ(temperature_history(0, TEMPERATURE_MINUTE, two, 2), 2);
+    CHECK(memcmp(&two[1], &history[n - 1], sizeof(two[1])) == 0);
+    CHECK(memcmp(&two[0], &history[n - 2], sizeof(two[0])) == 0);
+}
+
+static void test_format(void) {
+    static const struct {
+        int16_t cc;
+        const char *text;
+    } cases[] = {
+        {2700, "27.0"}, {2345, "23.5"}, {2344, "23.4"}, {99, "1.0"},
+        {0, "0.0"}, {-5, "-0.1"}, {-1234, "-12.3"}, {-1235, "-12.4"},
+    };
+    char buf[8];
+    for (uint i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        temperature_format(cases[i].cc, buf, sizeof(buf));
+        if (strcmp(buf, cases[i].text) != 0)
+            fprintf(stderr, "%d cc: \"%s\", esperado \"%s\"\n", cases[i].cc, buf, cases[i].text);
+        CHECK(strcmp(buf, cases[i].text) == 0);
+    }
+}
+
+int main(void) {
+    sim_init();
+    sim_adc_set(ADC_CHANNEL_TEMPERATURE, 876);
+    adc_stream_init(TEMPERATURE_ADC_CHANNELS);
+    temperature_init();
+
+    test_format();
+    test_conversion();
+    test_minute_aggregate();
+    return test_result("temperature");
+}
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Gera o font_atlas.h (ASCII imprimível + Latin-1) a partir do font.h e font_extra.h.
+
+Os arquivos de entrada usam o formato do font.h: uma linha por caractere com
+8 bytes de coluna (bit 0 = linha de cima) e um comentário identificando o
+caractere. Letras acentuadas do Latin-1 que não estão nas entradas são compostas
+a partir da letra base e da marca diacrítica correspondente ("marca ...").
+
+Uso: gen_font_atlas.py font.h font_extra.h -o font_atlas.h
+"""
+import argparse
+import re
+import sys
+import unicodedata
+
+GLYPH_WIDTH = 8
+RANGES = [(0x20, 0x7E), (0xA0, 0xFF)]
+FALLBACK = '?'
+
+# Rótulos que não são o próprio caractere
+NAMED = {
+    'espaço': ' ',
+    'barra invertida': '\\',
+    'soft hyphen': '\u00ad',
+}
+
+# Marcas combinantes Unicode -> rótulo da marca no font_extra.h
+MARKS = {
+    '0300': 'marca grave',
+    '0301': 'marca aguda',
+    '0302': 'marca circunflexa',
+    '0303': 'marca til',
+    '0308': 'marca trema',
+    '030A': 'marca anel',
+    '0327': 'marca cedilha',
+}
+
+LINE_RE = re.compile(r'^\s*((?:0x[0-9a-fA-F]{2}\s*,?\s*){8})//\s*(.*?)\s*$')
+
+
+def parse(path):
+    """Retorna {rótulo: [8 colunas]} na ordem do arquivo."""
+    glyphs = {}
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            m = LINE_RE.match(line)
+            if not m:
+                continue
+            cols = [int(b, 16) for b in re.findall(r'0x[0-9a-fA-F]{2}', m.group(1))]
+            glyphs[m.group(2)] = cols
+    return glyphs
+
+
+def ink_columns(cols):
+    used = [i for i, c in enumerate(cols) if c]
+    return (used[0], used[-1]) if used else (0, GLYPH_WIDTH - 1)
+
+
+def squash_capital(cols):
+    """Reduz uma maiúscula de 7 linhas (0-6) para 6 linhas (2-7), abrindo espaço
+    para a marca. Remove a linha interna cuja fusão com a de baixo perde menos pixels."""
+    def bit(c, r):
+        return (c >> r) & 1
+
+    cost = {r: sum(bit(c, r) != bit(c, r + 1) for c in cols) for r in range(1, 6)}
+    drop = min(cost, key=lambda r: (cost[r], abs(r - 3)))
+    out = []
+    for c in cols:
+        rows = [bit(c, r) for r in range(7) if r != drop]
+        out.append(sum(b << (r + 2) for r, b in enumerate(rows)))
+    return out
+
+
+def compose(base, mark, capital):
+    above = not any(c & 0x80 for c in mark)
+    if above:
+        base = squash_capital(base) if capital else [c & ~0x03 for c in base]
+    b0, b1 = ink_columns(base)
+    m0, m1 = ink_columns(mark)
+    shift = (b0 + b1 - m0 - m1 + 1) // 2
+    out = list(base)
+    for i, c in enumerate(mark):
+        j = i + shift
+        if c and 0 <= j < GLYPH_WIDTH:
+            out[j] |= c
+    return out
+
+
+def build(sources):
+    chars = {}
+    marks = {}
+    for path in sources:
+        for label, cols in parse(path).items():
+            if label.startswith('marca '):
+                marks[label] = cols
+                continue
+            ch = NAMED.get(label, label)
+            if len(ch) == 1:
+                chars[ch] = cols
+
+    atlas = []
+    for first, last in RANGES:
+        for cp in range(first, last + 1):
+            ch = chr(cp)
+            if ch in chars:
+                atlas.append((cp, chars[ch]))
+                continue
+            decomp = unicodedata.decomposition(ch).split()
+            if decomp and decomp[0] == '<noBreak>':
+                atlas.append((cp, chars[chr(int(decomp[1], 16))]))
+                continue
+            if len(decomp) == 2 and decomp[1] in MARKS:
+                base = chars[chr(int(decomp[0], 16))]
+                mark = marks[MARKS[decomp[1]]]
+                capital = unicodedata.category(ch) == 'Lu'
+                atlas.append((cp, compose(base, mark, capital)))
+                continue
+            sys.exit('gen_font_atlas: sem glifo para U+%04X %r' % (cp, ch))
+    return atlas
+
+
+def emit(atlas, sources):
+    index = {cp: i for i, (cp, _) in enumerate(atlas)}
+    lines = [
+        '// Gerado por tools/gen_font_atlas.py a partir de %s. Não edite.' % ' e '.join(sources),
+        '#ifndef FONT_ATLAS_H',
+        '#define FONT_ATLAS_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#define FONT_ATLAS_GLYPH_WIDTH %d' % GLYPH_WIDTH,
+        '#define FONT_ATLAS_GLYPHS %d' % len(atlas),
+        '#define FONT_ATLAS_FALLBACK %d // %r' % (index[ord(FALLBACK)], FALLBACK),
+        '',
+        '// Glifos 8x8 em colunas (bit 0 = linha de cima), na ordem dos code points',
+        'static const uint8_t font_atlas[FONT_ATLAS_GLYPHS][FONT_ATLAS_GLYPH_WIDTH] = {',
+    ]
+    for cp, cols in atlas:
+        name = unicodedata.name(chr(cp), 'U+%04X' % cp).lower()
+        lines.append('    {%s}, // U+%04X %s' % (', '.join('0x%02x' % c for c in cols), cp, name))
+    lines += ['};', '', '// Índice do glifo de um code point; o que não está no atlas vira %r' % FALLBACK,
+              'static inline uint16_t font_atlas_index(uint32_t cp) {']
+    offset = 0
+    for first, last in RANGES:
+        lines.append('    if (cp >= 0x%02X && cp <= 0x%02X)' % (first, last))
+        lines.append('        return (uint16_t)(cp - 0x%02X + %d);' % (first, offset))
+        offset += last - first + 1
+    lines += ['    return FONT_ATLAS_FALLBACK;', '}', '', '#endif // FONT_ATLAS_H', '']
+    return '\n'.join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('sources', nargs='+')
+    ap.add_argument('-o', '--output', required=True)
+    args = ap.parse_args()
+    atlas = build(args.sources)
+    names = [s.replace('\\', '/').rsplit('/', 1)[-1] for s in args.sources]
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write(emit(atlas, names))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Gera o led_lut.h (tabela de gama e brilho global da matriz de LEDs).
+
+Cada entrada converte um canal de 8 bits pedido pelo firmware no ciclo de
+trabalho enviado ao WS2812: round(255 * (v / 255) ** gama * brilho / 255). Um
+canal aceso nunca vira 0, para que cores fracas não desapareçam com o brilho
+reduzido.
+
+Uso: gen_led_lut.py --gamma 2.2 --brightness 64 -o led_lut.h
+"""
+import argparse
+import sys
+
+
+def table(gamma, brightness):
+    out = []
+    for v in range(256):
+        level = round(255 * (v / 255) ** gamma * brightness / 255)
+        out.append(max(level, 1) if v and brightness else level)
+    return out
+
+
+def emit(values, gamma, brightness):
+    lines = [
+        '// Gerado por tools/gen_led_lut.py (gama %g, brilho %d/255). Não edite.' % (gamma, brightness),
+        '#ifndef LED_LUT_H',
+        '#define LED_LUT_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#define LED_LUT_GAMMA_X100 %d' % round(gamma * 100),
+        '#define LED_LUT_BRIGHTNESS %d' % brightness,
+        '',
+        '// Canal pedido -> ciclo de trabalho no WS2812',
+        'static const uint8_t led_lut[256] = {',
+    ]
+    for row in range(0, 256, 16):
+        lines.append('    ' + ', '.join('%3d' % v for v in values[row:row + 16]) + ',')
+    lines += ['};', '', '#endif // LED_LUT_H', '']
+    return '\n'.join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('--gamma', type=float, default=2.2)
+    ap.add_argument('--brightness', type=int, default=255)
+    ap.add_argument('-o', '--output', required=True)
+    args = ap.parse_args()
+    if args.gamma <= 0:
+        sys.exit('gama deve ser positiva')
+    if not 0 <= args.brightness <= 255:
+        sys.exit('brilho deve estar entre 0 e 255')
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write(emit(table(args.gamma, args.brightness), args.gamma, args.brightness))
+
+
+if __name__ == '__main__':
+    main()
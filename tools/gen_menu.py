@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Gera o menu_tables.h (tabelas constantes da árvore do menu) a partir do menu.txt.
+
+Cada linha do arquivo é um item; a indentação (4 espaços por nível) diz a que
+submenu ele pertence. "Título -> funcao" é uma ação, "Título <-" volta ao menu
+anterior e um título sozinho abre os itens indentados abaixo dele.
+
+Os itens são numerados em largura a partir da raiz (índice 0, o menu
+principal), de modo que os filhos de cada submenu ficam contíguos. Cada item
+leva o índice do pai, do primeiro filho, o número de filhos, a posição entre os
+irmãos, o tipo e a largura do título em pixels.
+
+Uso: gen_menu.py menu.txt -o menu_tables.h
+"""
+import argparse
+import re
+import sys
+from collections import deque
+
+from gen_font_atlas import GLYPH_WIDTH
+
+INDENT = 4
+MAX_ITEMS = 0xFFFF
+IDENT_RE = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+
+
+class Item:
+    def __init__(self, title, kind, action=None, line=0):
+        self.title = title
+        self.kind = kind
+        self.action = action
+        self.line = line
+        self.children = []
+        self.parent = None
+        self.index = 0
+
+
+def fail(path, line, msg):
+    sys.exit('%s:%d: %s' % (path, line, msg))
+
+
+def parse(path):
+    root = Item(None, 'ITEM_SUBMENU')
+    stack = [root]  # stack[n] = submenu aberto no nível n
+    with open(path, encoding='utf-8') as f:
+        for number, raw in enumerate(f, 1):
+            text = raw.rstrip('\n').rstrip()
+            if not text.strip() or text.lstrip().startswith('#'):
+                continue
+            if '\t' in text:
+                fail(path, number, 'use espaços na indentação')
+            spaces = len(text) - len(text.lstrip(' '))
+            if spaces % INDENT:
+                fail(path, number, 'indentação deve ser múltipla de %d espaços' % INDENT)
+            level = spaces // INDENT + 1
+            if level > len(stack):
+                fail(path, number, 'item indentado sem submenu acima')
+            body = text.strip()
+            if '->' in body:
+                title, action = (s.strip() for s in body.split('->', 1))
+                if not IDENT_RE.match(action):
+                    fail(path, number, 'nome de função inválido: %r' % action)
+                item = Item(title, 'ITEM_ACAO', action, number)
+            elif body.endswith('<-'):
+                item = Item(body[:-2].strip(), 'ITEM_VOLTAR', line=number)
+                if level == 1:
+                    fail(path, number, '"voltar" no menu principal')
+            else:
+                item = Item(body, 'ITEM_SUBMENU', line=number)
+            if not item.title:
+                fail(path, number, 'item sem título')
+            del stack[level:]
+            item.parent = stack[-1]
+            stack[-1].children.append(item)
+            if item.kind == 'ITEM_SUBMENU':
+                stack.append(item)
+    return root
+
+
+def number_items(root, path):
+    """Ordem em largura: os filhos de cada submenu ficam contíguos."""
+    order = []
+    queue = deque([root])
+    while queue:
+        item = queue.popleft()
+        item.index = len(order)
+        order.append(item)
+        if item.kind == 'ITEM_SUBMENU' and not item.children:
+            fail(path, item.line, 'submenu vazio: %r' % item.title)
+        queue.extend(item.children)
+    if len(order) > MAX_ITEMS:
+        sys.exit('%s: mais de %d itens' % (path, MAX_ITEMS))
+    return order
+
+
+def depth(item):
+    return 1 + max((depth(c) for c in item.children), default=0) if item.children else 0
+
+
+def c_string(s):
+    return '"%s"' % s.replace('\\', '\\\\').replace('"', '\\"')
+
+
+def emit(root, order, source):
+    actions = sorted({i.action for i in order if i.action})
+    lines = [
+        '// Gerado por tools/gen_menu.py a partir de %s. Não edite.' % source,
+        '#ifndef MENU_TABLES_H',
+        '#define MENU_TABLES_H',
+        '',
+        '#include <stddef.h>',
+        '#include "menu.h"',
+        '',
+        '// Ações referenciadas pelo menu',
+    ]
+    lines += ['void %s(void);' % a for a in actions]
+    lines += [
+        '',
+        '#define MENU_NUM_ITENS %d' % len(order),
+        '#define MENU_PROFUNDIDADE %d // Níveis abaixo do menu principal' % depth(root),
+        '',
+        '// {titulo, acao, pai, primeiro_filho, num_filhos, posicao, tipo, largura}',
+        'static const ItemMenu menu_itens[MENU_NUM_ITENS] = {',
+    ]
+    for item in order:
+        parent = item.parent.index if item.parent else item.index
+        position = item.parent.children.index(item) if item.parent else 0
+        first = item.children[0].index if item.children else 0
+        width = min(len(item.title) * GLYPH_WIDTH, 255) if item.title else 0
+        lines.append('    {%s, %s, %d, %d, %d, %d, %s, %d}, // %d' % (
+            c_string(item.title) if item.title else 'NULL', item.action or 'NULL',
+            parent, first, len(item.children), position, item.kind, width, item.index))
+    lines += ['};', '', '#endif // MENU_TABLES_H', '']
+    return '\n'.join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('source')
+    ap.add_argument('-o', '--output', required=True)
+    args = ap.parse_args()
+    root = parse(args.source)
+    order = number_items(root, args.source)
+    name = args.source.replace('\\', '/').rsplit('/', 1)[-1]
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write(emit(root, order, name))
+
+
+if __name__ == '__main__':
+    main()
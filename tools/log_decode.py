@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Decodifica o log binário do firmware (log.h) usando as strings de formato do ELF.
+
+O fluxo da USB mistura texto comum com registros COBS delimitados por 0x00; o
+texto é repassado como está e cada registro vira uma linha
+"[tempo] NÍVEL módulo: mensagem". O id de um registro é a posição da string de
+formato na seção log_fmt do ELF que está gravado na placa (ou do executável do
+host).
+
+Uso: log_decode.py firmware.elf captura.bin     ('-' lê da entrada padrão)
+     cat /dev/ttyACM0 | log_decode.py build/BitDogLab-Menu.elf -
+"""
+import argparse
+import re
+import struct
+import sys
+
+SECTION = 'log_fmt'
+LEVELS = ['ERROR', 'WARN', 'INFO', 'DEBUG']
+MODULES = ['sys', 'menu', 'input', 'oled', 'output']  # Mesma ordem de log_module_t
+MODULE_FRAME = 0xF  # LOG_MODULE_FRAME: quadros que não são registros (espelho do OLED)
+
+SPEC_RE = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXcsfFeEgG%])')
+
+
+def read_section(path, name):
+    """Conteúdo de uma seção de um ELF de 32 ou 64 bits little-endian."""
+    with open(path, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[5] != 1:
+        sys.exit(f'{path}: não é um ELF little-endian')
+    if elf[4] == 1:
+        shoff, = struct.unpack_from('<I', elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x2E)
+        shdr = '<IIIIIIIIII'
+    else:
+        shoff, = struct.unpack_from('<Q', elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x3A)
+        shdr = '<IIQQQQIIQQ'
+    sections = [struct.unpack_from(shdr, elf, shoff + i * shentsize) for i in range(shnum)]
+    names = sections[shstrndx]
+    for sh in sections:
+        start = names[4] + sh[0]
+        if elf[start:elf.index(b'\0', start)].decode() == name:
+            return elf[sh[4]:sh[4] + sh[5]]
+    sys.exit(f'{path}: seção {name} não encontrada (firmware sem log.h?)')
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame) + 1:
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def format_record(strings, data):
+    if len(data) < 8 or len(data) % 4:
+        return '<registro corrompido>'
+    words = list(struct.unpack(f'<{len(data) // 4}I', data))
+    header, ts = words[0], words[1]
+    args = words[2:]
+    fmt_id = header & 0xFFFF
+    module = (header >> 16) & 0xF
+    level = (header >> 20) & 0x3
+    core = (header >> 22) & 0x1
+    if fmt_id >= len(strings):
+        return f'<formato {fmt_id} fora da seção: ELF diferente do firmware?>'
+    fmt = strings[fmt_id:strings.index(b'\0', fmt_id)].decode('utf-8', 'replace')
+
+    def convert(m):
+        flags, length, conv = m.groups()
+        if conv == '%':
+            return '%'
+        if not args:
+            return '<?>'
+        if conv == 's':
+            size = args.pop(0)
+            nwords = (size + 3) // 4
+            raw = struct.pack(f'<{nwords}I', *args[:nwords])[:size]
+            del args[:nwords]
+            return ('%' + flags + 's') % raw.decode('utf-8', 'replace')
+        if conv in 'fFeEgG':
+            return ('%' + flags + conv) % struct.unpack('<f', struct.pack('<I', args.pop(0)))[0]
+        value = args.pop(0)
+        if length == 'll':
+            value |= (args.pop(0) if args else 0) << 32
+            bits = 64
+        else:
+            bits = 32
+        if conv in 'di' and value >> (bits - 1):
+            value -= 1 << bits
+        if conv == 'c':
+            return ('%' + flags + 'c') % chr(value & 0xFF)
+        return ('%' + flags + ('d' if conv in 'iu' else conv)) % value
+
+    text = SPEC_RE.sub(convert, fmt)
+    module_name = MODULES[module] if module < len(MODULES) else str(module)
+    return f'[{ts / 1e6:12.6f}] {LEVELS[level]:<5} {module_name}{"@1" if core else ""}: {text}'
+
+
+def decode(stream, strings, out):
+    text = bytearray()
+    frame = None
+    while True:
+        chunk = stream.read(1)
+        if not chunk:
+            break
+        byte = chunk[0]
+        if frame is None:
+            if byte == 0:
+                frame = bytearray()
+            else:
+                text.append(byte)
+                if byte == 0x0A:
+                    out.write(text.decode('utf-8', 'replace'))
+                    out.flush()
+                    text.clear()
+        elif byte == 0:
+            if frame:
+                data = cobs_decode(bytes(frame))
+                if not data or len(data) < 4 or (data[2] & 0xF) != MODULE_FRAME:
+                    out.write((format_record(strings, data) if data else '<registro corrompido>') + '\n')
+                    out.flush()
+                frame = None
+            # Dois 0x00 seguidos: fim de um registro e início do próximo
+        else:
+            frame.append(byte)
+    if text:
+        out.write(text.decode('utf-8', 'replace'))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('elf')
+    ap.add_argument('capture', help="captura da USB ('-' para a entrada padrão)")
+    args = ap.parse_args()
+
+    strings = read_section(args.elf, SECTION)
+    stream = sys.stdin.buffer if args.capture == '-' else open(args.capture, 'rb')
+    decode(stream, strings, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Visualizador do espelho do OLED enviado pela serial USB (mirror.h).
+
+Com a serial da placa, liga o espelho (MIRROR_CMD_START), confirma cada pacote
+(MIRROR_CMD_ACK) e desliga ao sair; com uma captura ('-' ou arquivo), só
+remonta os quadros. O quadro é desenhado no terminal com meios-blocos a cada
+pacote marcado como fim das mudanças e, com -o, gravado em PBM (mesmo formato
+do -o do executável do host). Texto e registros de log no fluxo são ignorados
+(ver log_decode.py).
+
+Uso: mirror_view.py /dev/ttyACM0 [-o oled.pbm]
+     ./build-host/BitDogLab-Menu-host -e "usb m; ..." | mirror_view.py - --no-screen -o oled.pbm
+"""
+import argparse
+import os
+import struct
+import sys
+
+WIDTH, HEIGHT = 128, 64
+PAGES = HEIGHT // 8
+HEADER = struct.Struct('<HBBBBBB')  # número, módulo, tipo, codificação|flags, página, coluna, colunas
+LOG_MODULE_FRAME = 0xF
+MIRROR_FRAME_TYPE = 0x01
+RAW, RLE, XOR_RLE = 0, 1, 2
+ENCODING_MASK = 0x03
+FLAG_RESET = 0x10
+FLAG_END = 0x20
+PAGE_START_LINE = 0x80
+CMD_START, CMD_STOP, CMD_ACK = b'm', b'M', b'k'
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame) + 1:
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def unpackbits(data, count):
+    out = bytearray()
+    i = 0
+    while i < len(data) and len(out) < count:
+        n = data[i]
+        i += 1
+        if n < 128:
+            out += data[i:i + n + 1]
+            i += n + 1
+        elif n > 128:
+            out += bytes([data[i]]) * (257 - n)
+            i += 1
+    return bytes(out[:count])
+
+
+class Mirror:
+    def __init__(self):
+        self.ram = bytearray(WIDTH * PAGES)
+        self.start_line = 0
+        self.seq = None
+        self.lost = 0
+
+    def apply(self, packet):
+        """Aplica um pacote; retorna True se ele encerra as mudanças (redesenhar)."""
+        seq, _, _, flags, page, x0, count = HEADER.unpack_from(packet)
+        data = packet[HEADER.size:]
+        if flags & FLAG_RESET:
+            self.ram[:] = bytes(len(self.ram))
+            self.start_line = 0
+        elif self.seq is not None and seq != (self.seq + 1) & 0xFFFF:
+            self.lost += 1
+        self.seq = seq
+        if page == PAGE_START_LINE:
+            self.start_line = x0 % HEIGHT
+            return bool(flags & FLAG_END)
+        if page >= PAGES or x0 + count > WIDTH:
+            return False
+        start = page * WIDTH + x0
+        encoding = flags & ENCODING_MASK
+        if encoding == RAW:
+            span = data[:count]
+        else:
+            span = unpackbits(data, count)
+            if encoding == XOR_RLE:
+                span = bytes(a ^ b for a, b in zip(span, self.ram[start:start + count]))
+        self.ram[start:start + len(span)] = span
+        return bool(flags & FLAG_END)
+
+    def pixel(self, x, y):
+        y = (y + self.start_line) % HEIGHT  # Linha do painel -> linha da GDDRAM
+        return (self.ram[(y // 8) * WIDTH + x] >> (y % 8)) & 1
+
+    def draw(self, out):
+        lines = ['\x1b[H']
+        for y in range(0, HEIGHT, 2):
+            row = ''.join(' ▀▄█'[self.pixel(x, y) | self.pixel(x, y + 1) << 1] for x in range(WIDTH))
+            lines.append(row + '\n')
+        lines.append(f'pacote {self.seq}, perdas {self.lost}\x1b[K\n')
+        out.write(''.join(lines))
+        out.flush()
+
+    def save_pbm(self, path):
+        rows = bytearray()
+        for y in range(HEIGHT):
+            for x in range(0, WIDTH, 8):
+                byte = 0
+                for b in range(8):
+                    if not self.pixel(x + b, y):  # No PBM, 1 é preto
+                        byte |= 0x80 >> b
+                rows.append(byte)
+        with open(path, 'wb') as f:
+            f.write(f'P4\n{WIDTH} {HEIGHT}\n'.encode() + rows)
+
+
+def open_serial(path):
+    import termios
+    import tty
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    termios.tcflush(fd, termios.TCIFLUSH)
+    return fd
+
+
+def frames(read):
+    """Quadros COBS do fluxo (o texto entre eles é descartado)."""
+    frame = None
+    while True:
+        chunk = read()
+        if not chunk:
+            return
+        for byte in chunk:
+            if byte == 0:
+                if frame:
+                    yield cobs_decode(bytes(frame))
+                    frame = None
+                else:
+                    frame = bytearray()  # Início (dois 0x00 seguidos: fim e início)
+            elif frame is not None:
+                frame.append(byte)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('source', help="serial da placa, captura ou '-' para a entrada padrão")
+    ap.add_argument('-o', '--output', help='grava o quadro em PBM a cada atualização')
+    ap.add_argument('--no-screen', action='store_true', help='não desenha no terminal')
+    args = ap.parse_args()
+
+    serial = None
+    if args.source == '-':
+        read = lambda: sys.stdin.buffer.read1(4096)
+    elif os.path.exists(args.source) and not os.path.isfile(args.source):
+        serial = open_serial(args.source)
+        os.write(serial, CMD_START)
+        read = lambda: os.read(serial, 4096)
+    else:
+        capture = open(args.source, 'rb')
+        read = lambda: capture.read(4096)
+
+    mirror = Mirror()
+    if not args.no_screen:
+        sys.stdout.write('\x1b[2J')
+    try:
+        for packet in frames(read):
+            if not packet or len(packet) < HEADER.size:
+                continue
+            if packet[2] != LOG_MODULE_FRAME or packet[3] != MIRROR_FRAME_TYPE:
+                continue  # Registro de log
+            end = mirror.apply(packet)
+            if serial is not None:
+                os.write(serial, CMD_ACK)
+            if end:
+                if not args.no_screen:
+                    mirror.draw(sys.stdout)
+                if args.output:
+                    mirror.save_pbm(args.output)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if serial is not None:
+            os.write(serial, CMD_STOP)
+            os.close(serial)
+    if args.output:
+        mirror.save_pbm(args.output)
+    if mirror.lost:
+        print(f'{mirror.lost} pacotes perdidos', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
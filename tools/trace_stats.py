@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Percentis de latência por etapa a partir de um trace do firmware (trace_dump).
+
+A entrada pode ser o JSON puro ou o log da serial USB / do executável do host:
+nesse caso é usado o último trecho entre "---8<--- trace.json" e "---8<--- fim".
+Os pares B/E de cada núcleo são casados em pilha; eventos X já trazem a duração.
+Com -o, grava também o JSON recortado para abrir no chrome://tracing ou Perfetto.
+
+Uso: trace_stats.py captura.txt [-o trace.json]
+"""
+import argparse
+import json
+import sys
+from collections import defaultdict
+
+START_MARK = '---8<--- trace.json'
+END_MARK = '---8<--- fim'
+PERCENTILES = (50, 90, 99)
+
+
+def extract_json(text):
+    start = text.rfind(START_MARK)
+    if start < 0:
+        return text
+    body = text[start + len(START_MARK):]
+    end = body.find(END_MARK)
+    return body if end < 0 else body[:end]
+
+
+def durations(events):
+    """Agrupa as durações (us) por nome de etapa."""
+    stages = defaultdict(list)
+    open_spans = defaultdict(list)  # (tid, nome) -> pilha de inícios
+    unmatched = 0
+    for e in events:
+        ph, name, key = e.get('ph'), e.get('name'), (e.get('tid'), e.get('name'))
+        if ph == 'X':
+            stages[name].append(e['dur'])
+        elif ph == 'B':
+            open_spans[key].append(e['ts'])
+        elif ph == 'E':
+            if open_spans[key]:
+                stages[name].append((e['ts'] - open_spans[key].pop()) & 0xFFFFFFFF)
+            else:
+                unmatched += 1  # Início sobrescrito no anel
+    return stages, unmatched
+
+
+def percentile(values, p):
+    """Percentil pelo método do posto mais próximo."""
+    rank = max(1, -(-len(values) * p // 100))
+    return values[rank - 1]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('capture', help="log com o trace ou JSON ('-' para a entrada padrão)")
+    ap.add_argument('-o', '--output', help='grava o JSON do trace recortado')
+    args = ap.parse_args()
+
+    text = sys.stdin.read() if args.capture == '-' else open(args.capture, encoding='utf-8').read()
+    raw = extract_json(text)
+    try:
+        trace = json.loads(raw)
+    except json.JSONDecodeError as err:
+        sys.exit(f'{args.capture}: trace inválido ({err})')
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as out:
+            out.write(raw.strip() + '\n')
+
+    stages, unmatched = durations(trace.get('traceEvents', []))
+    header = ['etapa', 'n'] + [f'p{p}' for p in PERCENTILES] + ['max', 'media']
+    print(f'{header[0]:<22}' + ''.join(f'{h:>9}' for h in header[1:]) + '   (us)')
+    for name in sorted(stages, key=lambda n: -max(stages[n])):
+        values = sorted(stages[name])
+        cols = [len(values)] + [percentile(values, p) for p in PERCENTILES]
+        cols += [values[-1], round(sum(values) / len(values))]
+        print(f'{name:<22}' + ''.join(f'{c:>9}' for c in cols))
+
+    overwritten = trace.get('otherData', {}).get('overwritten', 0)
+    if overwritten or unmatched:
+        print(f'\n{overwritten} evento(s) sobrescrito(s) no anel, {unmatched} fim(ns) sem início')
+
+
+if __name__ == '__main__':
+    main()
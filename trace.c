@@ -0,0 +1,77 @@
+#include <stdatomic.h>
+#include <stdio.h>
+#include "trace.h"
+#include "hardware/sync.h"
+
+// Um anel por núcleo: cada núcleo só escreve no seu, e dentro do núcleo a reserva
+// da posição é feita com as interrupções mascaradas (poucos ciclos), então os
+// eventos de um anel ficam em ordem de tempo. Com o anel cheio, os mais antigos
+// são sobrescritos.
+typedef struct {
+    trace_event_t events[TRACE_RING_SIZE];
+    uint32_t head;   // Total de eventos gravados
+} trace_ring_t;
+
+#define TRACE_NAME(id, name) name,
+static const char *const point_names[TRACE_POINT_COUNT] = { TRACE_POINTS(TRACE_NAME) };
+#undef TRACE_NAME
+
+static trace_ring_t rings[2];
+static _Atomic bool paused;  // Durante trace_dump
+
+static void record(uint8_t point, uint8_t phase, uint32_t ts_us, uint32_t dur_us) {
+    if (atomic_load_explicit(&paused, memory_order_relaxed))
+        return;
+    trace_ring_t *ring = &rings[get_core_num()];
+    uint32_t irq = save_and_disable_interrupts();
+    if (phase != TRACE_PHASE_COMPLETE)
+        ts_us = time_us_32();
+    ring->events[ring->head & (TRACE_RING_SIZE - 1)] = (trace_event_t){ts_us, dur_us, point, phase};
+    ring->head++;
+    restore_interrupts(irq);
+}
+
+void trace_record(uint8_t point, uint8_t phase) {
+    record(point, phase, 0, 0);
+}
+
+void trace_complete(uint8_t point, uint32_t start_us, uint32_t end_us) {
+    record(point, TRACE_PHASE_COMPLETE, start_us, end_us - start_us);
+}
+
+uint32_t trace_overwritten(void) {
+    uint32_t lost = 0;
+    for (uint core = 0; core < 2; core++)
+        if (rings[core].head > TRACE_RING_SIZE)
+            lost += rings[core].head - TRACE_RING_SIZE;
+    return lost;
+}
+
+// Imprime os dois anéis como JSON do Chrome trace-event, entre linhas marcadoras
+// para que o trecho possa ser recortado do log serial. A gravação fica suspensa
+// durante a impressão; os anéis não são esvaziados.
+void trace_dump(void) {
+    atomic_store_explicit(&paused, true, memory_order_relaxed);
+    printf("---8<--- trace.json\n");
+    printf("{\"displayTimeUnit\": \"ms\", \"otherData\": {\"overwritten\": %lu}, \"traceEvents\": [\n",
+           (unsigned long)trace_overwritten());
+    printf("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"core0\"}},\n");
+    printf("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"core1\"}}");
+    for (uint core = 0; core < 2; core++) {
+        const trace_ring_t *ring = &rings[core];
+        uint32_t first = ring->head > TRACE_RING_SIZE ? ring->head - TRACE_RING_SIZE : 0;
+        for (uint32_t i = first; i != ring->head; i++) {
+            const trace_event_t *e = &ring->events[i & (TRACE_RING_SIZE - 1)];
+            const char *name = e->point < TRACE_POINT_COUNT ? point_names[e->point] : "?";
+            printf(",\n{\"name\": \"%s\", \"cat\": \"bitdoglab\", \"ph\": \"%c\", \"ts\": %lu, \"pid\": 1, \"tid\": %u",
+                   name, e->phase, (unsigned long)e->ts_us, core);
+            if (e->phase == TRACE_PHASE_COMPLETE)
+                printf(", \"dur\": %lu", (unsigned long)e->dur_us);
+            else if (e->phase == TRACE_PHASE_INSTANT)
+                printf(", \"s\": \"t\"");
+            printf("}");
+        }
+    }
+    printf("\n]}\n---8<--- fim\n");
+    atomic_store_explicit(&paused, false, memory_order_relaxed);
+}
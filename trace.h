@@ -0,0 +1,68 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Rastreamento do caminho entrada -> tela: eventos de início/fim com carimbo de
+// tempo gravados num anel fixo em RAM (um por núcleo, sem alocação). trace_dump
+// imprime o anel no formato Chrome trace-event (chrome://tracing, Perfetto);
+// tools/trace_stats.py calcula os percentis de cada etapa.
+//
+// Com BITDOGLAB_TRACE=0 as macros não geram código.
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+#ifndef BITDOGLAB_TRACE
+#define BITDOGLAB_TRACE 0
+#endif
+
+#define TRACE_RING_SIZE 256  // Eventos por núcleo (potência de 2)
+
+// Pontos de rastreamento: identificador e nome exibido no trace
+#define TRACE_POINTS(X)                                 \
+    X(TRACE_INPUT_IRQ, "input_irq")                     \
+    X(TRACE_JOYSTICK, "joystick_sample")                \
+    X(TRACE_SELECT, "opcao_selecionada")                \
+    X(TRACE_DRAW_MENU, "mostrar_menu")                  \
+    X(TRACE_FRAME_READY, "output_frame_ready")          \
+    X(TRACE_FLUSH_START, "ssd1306_flush_start")         \
+    X(TRACE_FLUSH, "oled_i2c")                          \
+    X(TRACE_LEDS, "led_matrix_send")                    \
+    X(TRACE_LEDS_WIRE, "ws2812_dma")                    \
+    X(TRACE_INPUT_TO_PHOTON, "input_to_photon")
+
+#define TRACE_ENUM(id, name) id,
+typedef enum { TRACE_POINTS(TRACE_ENUM) TRACE_POINT_COUNT } trace_point_t;
+#undef TRACE_ENUM
+
+typedef enum {
+    TRACE_PHASE_BEGIN = 'B',
+    TRACE_PHASE_END = 'E',
+    TRACE_PHASE_INSTANT = 'i',
+    TRACE_PHASE_COMPLETE = 'X'   // Intervalo já medido (início e duração)
+} trace_phase_t;
+
+typedef struct {
+    uint32_t ts_us;    // time_us_32()
+    uint32_t dur_us;   // Só em TRACE_PHASE_COMPLETE
+    uint8_t point;     // trace_point_t
+    uint8_t phase;     // trace_phase_t
+} trace_event_t;
+
+void trace_record(uint8_t point, uint8_t phase);
+void trace_complete(uint8_t point, uint32_t start_us, uint32_t end_us);
+void trace_dump(void);
+uint32_t trace_overwritten(void);
+
+#if BITDOGLAB_TRACE
+#define TRACE_BEGIN(point) trace_record((point), TRACE_PHASE_BEGIN)
+#define TRACE_END(point) trace_record((point), TRACE_PHASE_END)
+#define TRACE_INSTANT(point) trace_record((point), TRACE_PHASE_INSTANT)
+#define TRACE_COMPLETE(point, start_us, end_us) trace_complete((point), (start_us), (end_us))
+#else
+#define TRACE_BEGIN(point) ((void)0)
+#define TRACE_END(point) ((void)0)
+#define TRACE_INSTANT(point) ((void)0)
+#define TRACE_COMPLETE(point, start_us, end_us) ((void)0)
+#endif
+
+#endif // TRACE_H